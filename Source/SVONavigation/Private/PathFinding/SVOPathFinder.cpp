@@ -44,39 +44,38 @@ namespace
     }
 }
 
-ENavigationQueryResult::Type FSVOPathFinder::GetPath( FSVONavigationPath & navigation_path, const ASVONavigationData & navigation_data, const FVector & start_location, const FVector & end_location, FSharedConstNavQueryFilter nav_query_filter )
+ENavigationQueryResult::Type FSVOPathFinder::GetPath( FSVONavigationPath & navigation_path, const ASVONavigationData & navigation_data, const FSVOVolumeNavigationData & volume_navigation_data, const FVector & start_location, const FVector & end_location, FSharedConstNavQueryFilter nav_query_filter )
 {
-    if ( const auto * volume_navigation_data = navigation_data.GetVolumeNavigationDataContainingPoints( { start_location, end_location } ) )
+    LLM_SCOPE_BYTAG( SVONavigation );
+
+    if ( auto * settings = GetDefault< USVONavigationSettings >() )
     {
-        if ( auto * settings = GetDefault< USVONavigationSettings >() )
+        if ( settings->DefaultRaycasterClass != nullptr )
         {
-            if ( settings->DefaultRaycasterClass != nullptr )
+            if ( !settings->DefaultRaycasterClass->GetDefaultObject< USVORayCaster >()->Trace( volume_navigation_data, start_location, end_location ) )
             {
-                if ( !settings->DefaultRaycasterClass->GetDefaultObject< USVORayCaster >()->Trace( *volume_navigation_data, start_location, end_location ) )
-                {
-                    auto & path_points = navigation_path.GetPathPoints();
-                    path_points.Emplace( start_location );
-                    path_points.Emplace( end_location );
-                    navigation_path.MarkReady();
-
-                    return ENavigationQueryResult::Success;
-                }
+                auto & path_points = navigation_path.GetPathPoints();
+                path_points.Emplace( start_location );
+                path_points.Emplace( end_location );
+                navigation_path.MarkReady();
+
+                return ENavigationQueryResult::Success;
             }
         }
+    }
 
-        const auto volume_navigation_query_filter = volume_navigation_data->GetVolumeNavigationQueryFilter();
+    const auto volume_navigation_query_filter = volume_navigation_data.GetVolumeNavigationQueryFilter();
 
-        const auto navigation_query_filter_copy = volume_navigation_query_filter != nullptr
-                                                      ? volume_navigation_query_filter.GetDefaultObject()->GetQueryFilter( navigation_data, nullptr )
-                                                      : nav_query_filter;
+    const auto navigation_query_filter_copy = volume_navigation_query_filter != nullptr
+                                                  ? volume_navigation_query_filter.GetDefaultObject()->GetQueryFilter( navigation_data, nullptr )
+                                                  : nav_query_filter;
 
-        if ( const auto * path_finder = GetPathFindingAlgorithm( navigation_query_filter_copy ) )
+    if ( const auto * path_finder = GetPathFindingAlgorithm( navigation_query_filter_copy ) )
+    {
+        const auto params = FSVOPathFindingParameters::Initialize( volume_navigation_data, start_location, end_location, *navigation_query_filter_copy );
+        if ( params.IsSet() )
         {
-            const auto params = FSVOPathFindingParameters::Initialize( *volume_navigation_data, start_location, end_location, *navigation_query_filter_copy );
-            if ( params.IsSet() )
-            {
-                return path_finder->GetPath( navigation_path, params.GetValue() );
-            }
+            return path_finder->GetPath( navigation_path, params.GetValue() );
         }
     }
 
@@ -3,6 +3,7 @@
 #include "PathFinding/SVOPathHeuristicCalculator.h"
 #include "PathFinding/SVOPathTraversalCostCalculator.h"
 #include "Pathfinding/SVONavigationQueryFilterImpl.h"
+#include "SVOMemoryReport.h"
 #include "SVONavigationData.h"
 #include "SVOVolumeNavigationData.h"
 
@@ -18,6 +19,11 @@ FSVOPathFindingAlgorithmStepper::FSVOPathFindingAlgorithmStepper( const FSVOPath
 {
 }
 
+FSVOPathFindingAlgorithmStepper::~FSVOPathFindingAlgorithmStepper()
+{
+    FSVONavigationDataMemoryReport::AddPathFindingNodePool( Graph.NodePool.GetAllocatedSize() + Graph.NodePool.NodeMap.GetAllocatedSize() + Graph.OpenList.GetAllocatedSize() );
+}
+
 void FSVOPathFindingAlgorithmStepper::AddObserver( const TSharedPtr< FSVOPathFindingAlgorithmObserver > observer )
 {
     Observers.Add( observer );
@@ -26,13 +26,13 @@ void FSVORayCasterObserver_GenerateDebugInfos::SetResult( const bool result )
 
 void FSVORayCasterObserver_GenerateDebugInfos::AddTraversedNode( FSVONodeAddress node_address, bool is_occluded )
 {
-    UE_LOG( LogTemp, Warning, TEXT( "Node Address : %i - %i - %i" ), node_address.LayerIndex, node_address.NodeIndex, node_address.SubNodeIndex );
+    UE_LOG( LogTemp, Warning, TEXT( "Node Address : %s" ), *node_address.ToString() );
     DebugInfos.TraversedNodes.Emplace( node_address, is_occluded );
 }
 
 void FSVORayCasterObserver_GenerateDebugInfos::AddTraversedLeafSubNode( FSVONodeAddress node_address, bool is_occluded )
 {
-    UE_LOG( LogTemp, Warning, TEXT( "SubNode Address : %i - %i - %i" ), node_address.LayerIndex, node_address.NodeIndex, node_address.SubNodeIndex );
+    UE_LOG( LogTemp, Warning, TEXT( "SubNode Address : %s" ), *node_address.ToString() );
     DebugInfos.TraversedLeafSubNodes.Emplace( node_address, is_occluded );
 }
 
@@ -43,7 +43,9 @@ bool USVORayCaster::Trace( const FSVOVolumeNavigationData & volume_navigation_da
         Observer->Initialize( &volume_navigation_data, from, to );
     }
 
-    const auto result = TraceInternal( volume_navigation_data, from, to );
+    // The dynamic obstacles are not part of the octree nor of the physics scene
+    const auto result = volume_navigation_data.GetDynamicObstacles().DoesSegmentIntersectObstacle( from, to )
+                        || TraceInternal( volume_navigation_data, from, to );
 
     if ( Observer.IsValid() )
     {
@@ -39,7 +39,7 @@ FSVORayCasterSceneProxy::FSVORayCasterSceneProxy( const UPrimitiveComponent & co
     const auto draw_morton_coords = [ &debug_draw_options, this ]( const FVector & location, const FSVONodeAddress node_address ) {
         if ( debug_draw_options.bDrawMortonCode )
         {
-            Texts.Emplace( FString::Printf( TEXT( "%i:%i:%i" ), node_address.LayerIndex, node_address.NodeIndex, node_address.SubNodeIndex ), location + FVector( 0.0f, 0.0f, 40.0f ), FLinearColor::Black );
+            Texts.Emplace( node_address.ToString(), location + FVector( 0.0f, 0.0f, 40.0f ), FLinearColor::Black );
         }
     };
 
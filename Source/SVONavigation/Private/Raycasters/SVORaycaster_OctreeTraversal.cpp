@@ -495,14 +495,13 @@ bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedLeaf( const FOctreeR
 
 bool USVORayCaster_OctreeTraversal::DoesRayIntersectOccludedNormalNode( const FOctreeRay & ray, const FSVONodeAddress & node_address, const FSVOVolumeNavigationData & data ) const
 {
-    const auto & node = data.GetData().GetLayer( node_address.LayerIndex ).GetNode( node_address.NodeIndex );
+    const auto & first_child_address = data.GetData().GetLayer( node_address.LayerIndex ).GetNodeFirstChild( node_address.NodeIndex );
 
-    if ( !node.HasChildren() )
+    if ( !first_child_address.IsValid() )
     {
         return false;
     }
 
-    const auto & first_child_address = node.FirstChild;
     auto child_index = GetFirstNodeIndex( FOctreeRay( ray.tx0, ray.txm, ray.ty0, ray.tym, ray.tz0, ray.tzm ) );
 
     do
@@ -0,0 +1,268 @@
+#include "SVODynamicObstacles.h"
+
+#include "SVOHelpers.h"
+#include "SVONavigationStats.h"
+
+namespace
+{
+    // Boxes which only share a face don't overlap, so the free nodes next to an obstacle are not blocked
+    bool DoBoxesOverlap( const FBox & first, const FBox & second )
+    {
+        return first.Min.X < second.Max.X && first.Max.X > second.Min.X
+            && first.Min.Y < second.Max.Y && first.Max.Y > second.Min.Y
+            && first.Min.Z < second.Max.Z && first.Max.Z > second.Min.Z;
+    }
+}
+
+FSVODynamicObstacle FSVODynamicObstacle::MakeBox( const FBox & box )
+{
+    FSVODynamicObstacle obstacle;
+    obstacle.Bounds = box;
+    obstacle.Shape = ESVODynamicObstacleShape::Box;
+    obstacle.SphereRadius = 0.0f;
+    return obstacle;
+}
+
+FSVODynamicObstacle FSVODynamicObstacle::MakeSphere( const FVector & center, const float radius )
+{
+    FSVODynamicObstacle obstacle;
+    obstacle.Bounds = FBox::BuildAABB( center, FVector( radius ) );
+    obstacle.Shape = ESVODynamicObstacleShape::Sphere;
+    obstacle.SphereRadius = radius;
+    return obstacle;
+}
+
+bool FSVODynamicObstacle::IntersectsBox( const FBox & box ) const
+{
+    if ( !DoBoxesOverlap( Bounds, box ) )
+    {
+        return false;
+    }
+
+    if ( Shape == ESVODynamicObstacleShape::Sphere )
+    {
+        return FMath::SphereAABBIntersection( Bounds.GetCenter(), FMath::Square( SphereRadius ), box );
+    }
+
+    return true;
+}
+
+bool FSVODynamicObstacle::IntersectsSegment( const FVector & from, const FVector & to ) const
+{
+    if ( Shape == ESVODynamicObstacleShape::Sphere )
+    {
+        return FMath::PointDistToSegmentSquared( Bounds.GetCenter(), from, to ) <= FMath::Square( SphereRadius );
+    }
+
+    return FMath::LineBoxIntersection( Bounds, from, to, to - from );
+}
+
+FSVODynamicObstacles::FSVODynamicObstacles()
+{
+    RebuildFilter();
+}
+
+void FSVODynamicObstacles::Add( const int32 obstacle_id, const FSVODynamicObstacle & obstacle, const FSVOData & data )
+{
+    LLM_SCOPE_BYTAG( SVONavigation );
+
+    Remove( obstacle_id );
+
+    auto & entry = Obstacles.Add( obstacle_id );
+    entry.Obstacle = obstacle;
+    RasterizeObstacle( entry, data );
+}
+
+bool FSVODynamicObstacles::Remove( const int32 obstacle_id )
+{
+    FObstacleEntry entry;
+    if ( !Obstacles.RemoveAndCopyValue( obstacle_id, entry ) )
+    {
+        return false;
+    }
+
+    for ( const auto & node_address : entry.BlockedNodes )
+    {
+        auto & count = BlockedNodeCounts.FindChecked( node_address );
+        if ( --count == 0 )
+        {
+            BlockedNodeCounts.Remove( node_address );
+        }
+    }
+
+    // Other obstacles may still occlude some sub nodes of the leaves of this obstacle
+    for ( const auto & pair : entry.LeafSubNodes )
+    {
+        uint64 sub_nodes = 0;
+
+        for ( const auto & other_pair : Obstacles )
+        {
+            if ( const auto * other_sub_nodes = other_pair.Value.LeafSubNodes.Find( pair.Key ) )
+            {
+                sub_nodes |= *other_sub_nodes;
+            }
+        }
+
+        if ( sub_nodes == 0 )
+        {
+            LeafSubNodes.Remove( pair.Key );
+        }
+        else
+        {
+            LeafSubNodes[ pair.Key ] = sub_nodes;
+        }
+    }
+
+    RebuildFilter();
+
+    return true;
+}
+
+void FSVODynamicObstacles::Reset()
+{
+    Obstacles.Reset();
+    BlockedNodeCounts.Reset();
+    LeafSubNodes.Reset();
+    RebuildFilter();
+}
+
+bool FSVODynamicObstacles::IsNodeBlocked( const FSVONodeAddress & node_address ) const
+{
+    if ( !node_address.IsValid() || IsEmpty() || !IsInFilter( node_address.LayerIndex, node_address.NodeIndex ) )
+    {
+        return false;
+    }
+
+    if ( node_address.LayerIndex == 0 )
+    {
+        if ( const auto * sub_nodes = LeafSubNodes.Find( node_address.NodeIndex ) )
+        {
+            return ( *sub_nodes & 1ULL << node_address.SubNodeIndex ) != 0;
+        }
+    }
+
+    return BlockedNodeCounts.Contains( FSVONodeAddress( node_address.LayerIndex, node_address.NodeIndex, 0 ) );
+}
+
+bool FSVODynamicObstacles::DoesSegmentIntersectObstacle( const FVector & from, const FVector & to ) const
+{
+    for ( const auto & pair : Obstacles )
+    {
+        if ( pair.Value.Obstacle.IntersectsSegment( from, to ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int64 FSVODynamicObstacles::GetAllocatedSize() const
+{
+    int64 size = Obstacles.GetAllocatedSize() + BlockedNodeCounts.GetAllocatedSize() + LeafSubNodes.GetAllocatedSize();
+
+    for ( const auto & pair : Obstacles )
+    {
+        size += pair.Value.BlockedNodes.GetAllocatedSize() + pair.Value.LeafSubNodes.GetAllocatedSize();
+    }
+
+    return size;
+}
+
+void FSVODynamicObstacles::RasterizeObstacle( FObstacleEntry & entry, const FSVOData & data )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVODynamicObstacles_RasterizeObstacle );
+
+    const auto & navigation_bounds = data.GetNavigationBounds();
+
+    if ( !data.IsValid() || !DoBoxesOverlap( entry.Obstacle.Bounds, navigation_bounds ) )
+    {
+        return;
+    }
+
+    // The top layer has no node when nothing was occluded during the generation. There is then no node to block
+    if ( data.GetLastLayer().GetNodeCount() == 0 )
+    {
+        return;
+    }
+
+    const auto & leaf_nodes = data.GetLeafNodes();
+    const auto sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+
+    TArray< FSVONodeAddress, TInlineAllocator< 64 > > node_addresses_to_visit;
+    node_addresses_to_visit.Emplace( FSVONodeAddress( data.GetLayerCount() - 1, 0, 0 ) );
+
+    while ( node_addresses_to_visit.Num() > 0 )
+    {
+        const auto node_address = node_addresses_to_visit.Pop( false );
+        const auto & layer = data.GetLayer( node_address.LayerIndex );
+        const auto & first_child = layer.GetNodeFirstChild( node_address.NodeIndex );
+        const auto node_min = navigation_bounds.Min + FSVOHelpers::GetVectorFromMortonCode( layer.GetNodeMortonCode( node_address.NodeIndex ) ) * layer.GetNodeSize();
+
+        if ( !entry.Obstacle.IntersectsBox( FBox( node_min, node_min + FVector( layer.GetNodeSize() ) ) ) )
+        {
+            continue;
+        }
+
+        if ( !first_child.IsValid() )
+        {
+            entry.BlockedNodes.Add( node_address );
+            BlockedNodeCounts.FindOrAdd( node_address )++;
+            AddToFilter( node_address.LayerIndex, node_address.NodeIndex );
+            continue;
+        }
+
+        if ( node_address.LayerIndex > 0 )
+        {
+            for ( NodeIndex child_index = 0; child_index < 8; ++child_index )
+            {
+                node_addresses_to_visit.Emplace( FSVONodeAddress( first_child.LayerIndex, first_child.NodeIndex + child_index, 0 ) );
+            }
+            continue;
+        }
+
+        const auto leaf_index = first_child.NodeIndex;
+        const auto & leaf_node = leaf_nodes.GetLeafNode( leaf_index );
+        uint64 sub_nodes = 0;
+
+        for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; ++sub_node_index )
+        {
+            if ( leaf_node.IsSubNodeOccluded( sub_node_index ) )
+            {
+                continue;
+            }
+
+            const auto sub_node_min = node_min + FSVOHelpers::GetVectorFromMortonCode( sub_node_index ) * sub_node_size;
+
+            if ( entry.Obstacle.IntersectsBox( FBox( sub_node_min, sub_node_min + FVector( sub_node_size ) ) ) )
+            {
+                sub_nodes |= 1ULL << sub_node_index;
+            }
+        }
+
+        if ( sub_nodes != 0 )
+        {
+            entry.LeafSubNodes.Add( leaf_index, sub_nodes );
+            LeafSubNodes.FindOrAdd( leaf_index ) |= sub_nodes;
+            AddToFilter( 0, leaf_index );
+        }
+    }
+}
+
+void FSVODynamicObstacles::RebuildFilter()
+{
+    for ( auto & filter_bits : BlockedNodeFilter )
+    {
+        filter_bits = 0;
+    }
+
+    for ( const auto & pair : BlockedNodeCounts )
+    {
+        AddToFilter( pair.Key.LayerIndex, pair.Key.NodeIndex );
+    }
+
+    for ( const auto & pair : LeafSubNodes )
+    {
+        AddToFilter( 0, pair.Key );
+    }
+}
@@ -0,0 +1,210 @@
+#include "SVOGenerationCache.h"
+
+#include "SVOVersion.h"
+#include "SVOVolumeNavigationData.h"
+
+#include <Components/InstancedStaticMeshComponent.h>
+#include <Components/PrimitiveComponent.h>
+#include <HAL/FileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Misc/SecureHash.h>
+#include <PhysicsEngine/BodySetup.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+namespace
+{
+    template < typename _TYPE_ >
+    void UpdateHash( FSHA1 & hash, const _TYPE_ & value )
+    {
+        hash.Update( reinterpret_cast< const uint8 * >( &value ), sizeof( _TYPE_ ) );
+    }
+
+    void UpdateHash( FSHA1 & hash, const FString & value )
+    {
+        hash.UpdateWithString( *value, value.Len() );
+    }
+
+    void UpdateHash( FSHA1 & hash, const FTransform & transform )
+    {
+        UpdateHash( hash, transform.GetLocation() );
+        UpdateHash( hash, transform.GetRotation() );
+        UpdateHash( hash, transform.GetScale3D() );
+    }
+
+    FSHAHash HashComponent( const UPrimitiveComponent & component, const int32 item_index, const FTransform & transform, const ECollisionChannel collision_channel )
+    {
+        FSHA1 hash;
+
+        UpdateHash( hash, component.GetPathName() );
+        UpdateHash( hash, item_index );
+        UpdateHash( hash, transform );
+        // Catches the changes of the size of the shape components, whose collision is rebuilt from their properties
+        UpdateHash( hash, component.Bounds.Origin );
+        UpdateHash( hash, component.Bounds.BoxExtent );
+        UpdateHash( hash, static_cast< uint8 >( component.GetCollisionEnabled() ) );
+        UpdateHash( hash, static_cast< uint8 >( component.GetCollisionResponseToChannel( collision_channel ) ) );
+
+        // The guid changes each time the collision of a mesh is built again
+        if ( const auto * body_setup = const_cast< UPrimitiveComponent & >( component ).GetBodySetup() )
+        {
+            UpdateHash( hash, body_setup->BodySetupGuid );
+            UpdateHash( hash, static_cast< uint8 >( body_setup->GetCollisionTraceFlag() ) );
+        }
+
+        hash.Final();
+
+        FSHAHash result;
+        hash.GetHash( result.Hash );
+        return result;
+    }
+}
+
+FString FSVOGenerationCache::ComputeKey( const UWorld & world, const FBox & volume_bounds, const FSVODataGenerationSettings & generation_settings, const float voxel_extent )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGenerationCache_ComputeKey );
+
+    check( IsInGameThread() );
+
+    // The navigation bounds are a cube centered on the volume, and the rasterization boxes are expanded by the clearance
+    const auto bounds = FBox::BuildAABB( volume_bounds.GetCenter(), FVector( volume_bounds.GetSize().GetAbsMax() ) ).ExpandBy( generation_settings.Clearance );
+
+    TArray< FOverlapResult > overlap_results;
+
+    world.OverlapMultiByChannel( overlap_results,
+        bounds.GetCenter(),
+        FQuat::Identity,
+        generation_settings.CollisionChannel,
+        FCollisionShape::MakeBox( bounds.GetExtent() ),
+        generation_settings.CollisionQueryParameters );
+
+    // A component can be returned once per body instance
+    TSet< TPair< const UPrimitiveComponent *, int32 > > hashed_items;
+    TArray< FSHAHash > component_hashes;
+
+    for ( const auto & overlap_result : overlap_results )
+    {
+        const auto * component = overlap_result.GetComponent();
+
+        if ( component == nullptr || !component->CanEverAffectNavigation() )
+        {
+            continue;
+        }
+
+        const auto * instanced_static_mesh_component = Cast< UInstancedStaticMeshComponent >( component );
+        const auto item_index = instanced_static_mesh_component != nullptr ? overlap_result.ItemIndex : INDEX_NONE;
+
+        bool is_already_in_set;
+        hashed_items.Add( TPair< const UPrimitiveComponent *, int32 >( component, item_index ), &is_already_in_set );
+
+        if ( is_already_in_set )
+        {
+            continue;
+        }
+
+        auto transform = component->GetComponentTransform();
+
+        if ( instanced_static_mesh_component != nullptr && !instanced_static_mesh_component->GetInstanceTransform( item_index, transform, true ) )
+        {
+            continue;
+        }
+
+        component_hashes.Add( HashComponent( *component, item_index, transform, generation_settings.CollisionChannel ) );
+    }
+
+    // The overlaps are not returned in a deterministic order
+    component_hashes.Sort( []( const FSHAHash & left, const FSHAHash & right ) {
+        return FMemory::Memcmp( left.Hash, right.Hash, sizeof( left.Hash ) ) < 0;
+    } );
+
+    FSHA1 hash;
+
+    UpdateHash( hash, static_cast< uint8 >( ESVOVersion::Latest ) );
+    UpdateHash( hash, volume_bounds.Min );
+    UpdateHash( hash, volume_bounds.Max );
+    UpdateHash( hash, voxel_extent );
+    UpdateHash( hash, generation_settings.CollisionChannel.GetValue() );
+    UpdateHash( hash, generation_settings.Clearance );
+    UpdateHash( hash, generation_settings.CollisionQueryParameters.bTraceComplex );
+    UpdateHash( hash, static_cast< bool >( generation_settings.bUseGeometrySnapshot ) );
+    UpdateHash( hash, static_cast< bool >( generation_settings.bBuildMortonCodeIndex ) );
+    UpdateHash( hash, static_cast< bool >( generation_settings.bStoreNeighborLinks ) );
+
+    for ( const auto & component_hash : component_hashes )
+    {
+        hash.Update( component_hash.Hash, sizeof( component_hash.Hash ) );
+    }
+
+    hash.Final();
+
+    FSHAHash result;
+    hash.GetHash( result.Hash );
+    return result.ToString();
+}
+
+bool FSVOGenerationCache::Contains( const FString & key )
+{
+    return IFileManager::Get().FileExists( *GetFilePath( key ) );
+}
+
+bool FSVOGenerationCache::Load( FSVOVolumeNavigationData & volume_navigation_data, const FString & key )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGenerationCache_Load );
+
+    TArray< uint8 > bytes;
+    if ( !FFileHelper::LoadFileToArray( bytes, *GetFilePath( key ), FILEREAD_Silent ) )
+    {
+        return false;
+    }
+
+    FMemoryReader reader( bytes );
+
+    auto version = ESVOVersion::Initial;
+    reader << version;
+
+    if ( version != ESVOVersion::Latest )
+    {
+        return false;
+    }
+
+    FSVOVolumeNavigationData loaded_navigation_data;
+    loaded_navigation_data.Serialize( reader, version );
+
+    if ( reader.IsError() || !loaded_navigation_data.GetData().IsValid() )
+    {
+        return false;
+    }
+
+    volume_navigation_data = MoveTemp( loaded_navigation_data );
+    return true;
+}
+
+void FSVOGenerationCache::Save( FSVOVolumeNavigationData & volume_navigation_data, const FString & key )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGenerationCache_Save );
+
+    TArray< uint8 > bytes;
+    FMemoryWriter writer( bytes );
+
+    auto version = ESVOVersion::Latest;
+    writer << version;
+    volume_navigation_data.Serialize( writer, version );
+
+    // Volumes with the same key can be generated at the same time: write to a temporary file first so a reader never sees a partial file
+    const auto file_path = GetFilePath( key );
+    const auto temporary_file_path = FString::Printf( TEXT( "%s.%s.tmp" ), *file_path, *FGuid::NewGuid().ToString() );
+
+    if ( !FFileHelper::SaveArrayToFile( bytes, *temporary_file_path ) )
+    {
+        UE_LOG( LogNavigation, Warning, TEXT( "Failed to write the navigation data generation cache file %s" ), *temporary_file_path );
+        return;
+    }
+
+    IFileManager::Get().Move( *file_path, *temporary_file_path, true, true );
+}
+
+FString FSVOGenerationCache::GetFilePath( const FString & key )
+{
+    return FPaths::ProjectIntermediateDir() / TEXT( "SVONavigation" ) / key + TEXT( ".svo" );
+}
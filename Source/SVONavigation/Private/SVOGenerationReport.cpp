@@ -0,0 +1,146 @@
+#include "SVOGenerationReport.h"
+
+#include "SVOGenerationState.h"
+#include "SVONavigationData.h"
+#include "SVONavigationTypes.h"
+
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+namespace
+{
+    void DumpGenerationReports( const TArray< FString > & arguments, UWorld * world )
+    {
+        if ( world == nullptr )
+        {
+            return;
+        }
+
+        const auto write_csv = arguments.ContainsByPredicate( []( const FString & argument ) {
+            return argument.Equals( TEXT( "CSV" ), ESearchCase::IgnoreCase );
+        } );
+
+        FString csv = TEXT( "Map,NavigationData," ) + FSVOGenerationReport::GetCSVHeader() + LINE_TERMINATOR;
+
+        for ( TActorIterator< ASVONavigationData > iterator( world ); iterator; ++iterator )
+        {
+            const auto * navigation_data = *iterator;
+
+            for ( const auto & report : navigation_data->GetGenerationReports() )
+            {
+                UE_LOG( LogNavigation, Display, TEXT( "%s : %s" ), *navigation_data->GetName(), *report.ToString() );
+                csv += FString::Printf( TEXT( "%s,%s,%s%s" ), *world->GetMapName(), *navigation_data->GetName(), *report.ToCSVRow(), LINE_TERMINATOR );
+            }
+        }
+
+        if ( !write_csv )
+        {
+            return;
+        }
+
+        const auto file_path = FPaths::ProfilingDir() / TEXT( "SVONavigation" ) / FString::Printf( TEXT( "GenerationReports-%s-%s.csv" ), *world->GetMapName(), *FDateTime::Now().ToString() );
+
+        if ( FFileHelper::SaveStringToFile( csv, *file_path ) )
+        {
+            UE_LOG( LogNavigation, Display, TEXT( "Wrote the SVO navigation generation reports to %s" ), *file_path );
+        }
+        else
+        {
+            UE_LOG( LogNavigation, Warning, TEXT( "Failed to write the SVO navigation generation reports to %s" ), *file_path );
+        }
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs DumpGenerationReportsCommand(
+        TEXT( "SVONavigation.DumpGenerationReports" ),
+        TEXT( "Logs the report of the last generation of each volume of the SVO navigation data. Add CSV to also write them to a file in the profiling folder." ),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic( &DumpGenerationReports ) );
+}
+
+FSVOGenerationReport::FSVOGenerationReport() :
+    VolumeBounds( ForceInit ),
+    bIsUpdate( false ),
+    bIsLoadedFromCache( false ),
+    FirstPassTime( 0.0 ),
+    LeafRasterizationTime( 0.0 ),
+    LayersTime( 0.0 ),
+    NeighborLinksTime( 0.0 ),
+    OverlapQueryCount( 0 ),
+    LeafCount( 0 ),
+    PartiallyOccludedLeafCount( 0 ),
+    PeakAllocatedSize( 0 ),
+    AllocatedSize( 0 )
+{
+}
+
+FSVOGenerationReport FSVOGenerationReport::Make( const FBox & volume_bounds, const FSVOData & data, const FSVOGenerationState & generation_state, const bool is_update, const bool is_loaded_from_cache )
+{
+    FSVOGenerationReport report;
+    report.VolumeBounds = volume_bounds;
+    report.bIsUpdate = is_update;
+    report.bIsLoadedFromCache = is_loaded_from_cache;
+    report.FirstPassTime = generation_state.GetPhaseTime( ESVOGenerationPhase::FirstPass );
+    report.LeafRasterizationTime = generation_state.GetPhaseTime( ESVOGenerationPhase::LeafRasterization );
+    report.LayersTime = generation_state.GetPhaseTime( ESVOGenerationPhase::Layers );
+    report.NeighborLinksTime = generation_state.GetPhaseTime( ESVOGenerationPhase::NeighborLinks );
+    report.OverlapQueryCount = generation_state.GetOverlapQueryCount();
+    report.AllocatedSize = data.GetAllocatedSize();
+    report.PeakAllocatedSize = FMath::Max( generation_state.GetPeakAllocatedSize(), report.AllocatedSize );
+
+    const auto & leaf_nodes = data.GetLeafNodes();
+    report.LeafCount = leaf_nodes.GetLeafNodeCount();
+    report.PartiallyOccludedLeafCount = leaf_nodes.GetPartiallyOccludedLeafNodeCount();
+
+    return report;
+}
+
+FString FSVOGenerationReport::GetCSVHeader()
+{
+    return TEXT( "VolumeCenter,VolumeSize,IsUpdate,IsLoadedFromCache,FirstPassTime,LeafRasterizationTime,LayersTime,NeighborLinksTime,TotalTime,OverlapQueryCount,LeafCount,PartiallyOccludedLeafCount,PartiallyOccludedLeafRatio,PeakAllocatedSize,AllocatedSize" );
+}
+
+FString FSVOGenerationReport::ToCSVRow() const
+{
+    // The vectors are written without commas so they stay in one column
+    const auto center = VolumeBounds.GetCenter();
+    const auto size = VolumeBounds.GetSize();
+
+    return FString::Printf( TEXT( "%.0f %.0f %.0f,%.0f %.0f %.0f,%d,%d,%f,%f,%f,%f,%f,%d,%d,%d,%f,%lld,%lld" ),
+        center.X,
+        center.Y,
+        center.Z,
+        size.X,
+        size.Y,
+        size.Z,
+        bIsUpdate ? 1 : 0,
+        bIsLoadedFromCache ? 1 : 0,
+        FirstPassTime,
+        LeafRasterizationTime,
+        LayersTime,
+        NeighborLinksTime,
+        FirstPassTime + LeafRasterizationTime + LayersTime + NeighborLinksTime,
+        OverlapQueryCount,
+        LeafCount,
+        PartiallyOccludedLeafCount,
+        GetPartiallyOccludedLeafRatio(),
+        PeakAllocatedSize,
+        AllocatedSize );
+}
+
+FString FSVOGenerationReport::ToString() const
+{
+    return FString::Printf( TEXT( "Volume %s%s%s - First pass %.2fms, leaves %.2fms, layers %.2fms, neighbor links %.2fms - %d overlap queries - %d leaves, %.1f%% partially occluded - Peak %.2fKB, final %.2fKB" ),
+        *VolumeBounds.ToString(),
+        bIsUpdate ? TEXT( " (update)" ) : TEXT( "" ),
+        bIsLoadedFromCache ? TEXT( " (cache)" ) : TEXT( "" ),
+        FirstPassTime * 1000.0,
+        LeafRasterizationTime * 1000.0,
+        LayersTime * 1000.0,
+        NeighborLinksTime * 1000.0,
+        OverlapQueryCount,
+        LeafCount,
+        GetPartiallyOccludedLeafRatio() * 100.0f,
+        PeakAllocatedSize / 1024.0f,
+        AllocatedSize / 1024.0f );
+}
@@ -0,0 +1,62 @@
+#include "SVOGenerationState.h"
+
+namespace
+{
+    // Rough share of the generation time spent in each phase, indexed by ESVOGenerationPhase
+    constexpr float PhaseWeights[] = { 0.0f, 0.15f, 0.55f, 0.1f, 0.2f, 0.0f };
+}
+
+FSVOGenerationState::FSVOGenerationState() :
+    bIsCancelled( false ),
+    Phase( ESVOGenerationPhase::Pending ),
+    NodeCount( 0 ),
+    ProcessedNodeCount( 0 ),
+    OverlapQueryCount( 0 ),
+    PhaseStartTime( 0.0 ),
+    PhaseTimes( InPlace, 0.0 ),
+    PeakAllocatedSize( 0 )
+{
+}
+
+void FSVOGenerationState::BeginPhase( const ESVOGenerationPhase phase, const int32 node_count )
+{
+    const auto now = FPlatformTime::Seconds();
+    const auto previous_phase = GetPhase();
+
+    if ( previous_phase != ESVOGenerationPhase::Pending )
+    {
+        PhaseTimes[ static_cast< int32 >( previous_phase ) ] += now - PhaseStartTime;
+    }
+
+    PhaseStartTime = now;
+
+    ProcessedNodeCount.store( 0, std::memory_order_relaxed );
+    NodeCount.store( node_count, std::memory_order_relaxed );
+    Phase.store( phase, std::memory_order_relaxed );
+}
+
+float FSVOGenerationState::GetProgress() const
+{
+    const auto phase = GetPhase();
+
+    if ( phase == ESVOGenerationPhase::Done )
+    {
+        return 1.0f;
+    }
+
+    auto progress = 0.0f;
+
+    for ( auto phase_index = 0; phase_index < static_cast< int32 >( phase ); ++phase_index )
+    {
+        progress += PhaseWeights[ phase_index ];
+    }
+
+    const auto node_count = GetNodeCount();
+
+    if ( node_count > 0 )
+    {
+        progress += PhaseWeights[ static_cast< int32 >( phase ) ] * FMath::Min( 1.0f, static_cast< float >( GetProcessedNodeCount() ) / node_count );
+    }
+
+    return progress;
+}
@@ -0,0 +1,621 @@
+#include "SVOGeometrySnapshot.h"
+
+#include <Algo/Sort.h>
+#include <Components/InstancedStaticMeshComponent.h>
+#include <Components/PrimitiveComponent.h>
+#include <Interfaces/Interface_CollisionDataProvider.h>
+#include <Interface_CollisionDataProviderCore.h>
+#include <PhysicsEngine/BodySetup.h>
+
+namespace
+{
+    constexpr int32 MaxPrimitivesPerBVHLeaf = 4;
+
+    bool IsSeparatedOnAxis( const FVector & axis, const FVector & offset, const FVector & box_extent, const FVector * half_axes )
+    {
+        // Cross products of parallel edges
+        if ( axis.IsNearlyZero( KINDA_SMALL_NUMBER ) )
+        {
+            return false;
+        }
+
+        const auto box_radius = box_extent.X * FMath::Abs( axis.X ) + box_extent.Y * FMath::Abs( axis.Y ) + box_extent.Z * FMath::Abs( axis.Z );
+        const auto parallelepiped_radius = FMath::Abs( axis | half_axes[ 0 ] ) + FMath::Abs( axis | half_axes[ 1 ] ) + FMath::Abs( axis | half_axes[ 2 ] );
+
+        return FMath::Abs( axis | offset ) > box_radius + parallelepiped_radius;
+    }
+
+    // Separating axis test between an axis aligned box and a parallelepiped
+    bool DoesBoxIntersectParallelepiped( const FVector & box_center, const FVector & box_extent, const FVector & center, const FVector * half_axes )
+    {
+        const auto offset = center - box_center;
+        static const FVector box_axes[ 3 ] = { FVector::ForwardVector, FVector::RightVector, FVector::UpVector };
+
+        for ( const auto & box_axis : box_axes )
+        {
+            if ( IsSeparatedOnAxis( box_axis, offset, box_extent, half_axes ) )
+            {
+                return false;
+            }
+        }
+
+        for ( auto index = 0; index < 3; ++index )
+        {
+            if ( IsSeparatedOnAxis( half_axes[ index ] ^ half_axes[ ( index + 1 ) % 3 ], offset, box_extent, half_axes ) )
+            {
+                return false;
+            }
+        }
+
+        for ( const auto & box_axis : box_axes )
+        {
+            for ( auto index = 0; index < 3; ++index )
+            {
+                if ( IsSeparatedOnAxis( box_axis ^ half_axes[ index ], offset, box_extent, half_axes ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Separating axis test between an axis aligned box and a triangle (Akenine-Möller)
+    bool DoesBoxIntersectTriangle( const FVector & box_center, const FVector & box_extent, const FVector * triangle_vertices )
+    {
+        const FVector vertices[ 3 ] = {
+            triangle_vertices[ 0 ] - box_center,
+            triangle_vertices[ 1 ] - box_center,
+            triangle_vertices[ 2 ] - box_center
+        };
+        const FVector edges[ 3 ] = {
+            vertices[ 1 ] - vertices[ 0 ],
+            vertices[ 2 ] - vertices[ 1 ],
+            vertices[ 0 ] - vertices[ 2 ]
+        };
+        static const FVector box_axes[ 3 ] = { FVector::ForwardVector, FVector::RightVector, FVector::UpVector };
+
+        const auto is_separated_on_axis = [ & ]( const FVector & axis ) {
+            const auto p0 = axis | vertices[ 0 ];
+            const auto p1 = axis | vertices[ 1 ];
+            const auto p2 = axis | vertices[ 2 ];
+            const auto radius = box_extent.X * FMath::Abs( axis.X ) + box_extent.Y * FMath::Abs( axis.Y ) + box_extent.Z * FMath::Abs( axis.Z );
+
+            return FMath::Min3( p0, p1, p2 ) > radius || FMath::Max3( p0, p1, p2 ) < -radius;
+        };
+
+        for ( const auto & box_axis : box_axes )
+        {
+            for ( const auto & edge : edges )
+            {
+                if ( is_separated_on_axis( box_axis ^ edge ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        for ( const auto & box_axis : box_axes )
+        {
+            if ( is_separated_on_axis( box_axis ) )
+            {
+                return false;
+            }
+        }
+
+        return !is_separated_on_axis( edges[ 0 ] ^ edges[ 1 ] );
+    }
+
+    bool DoesBoxIntersectCapsule( const FBox & box, const FVector & start, const FVector & end, const float radius )
+    {
+        // The squared distance from a point of the segment to the box is convex along the segment, so a ternary search finds its minimum
+        auto min_ratio = 0.0f;
+        auto max_ratio = 1.0f;
+        const auto radius_squared = radius * radius;
+
+        for ( auto iteration = 0; iteration < 24; ++iteration )
+        {
+            const auto first_ratio = FMath::Lerp( min_ratio, max_ratio, 1.0f / 3.0f );
+            const auto second_ratio = FMath::Lerp( min_ratio, max_ratio, 2.0f / 3.0f );
+            const auto first_distance = box.ComputeSquaredDistanceToPoint( FMath::Lerp( start, end, first_ratio ) );
+            const auto second_distance = box.ComputeSquaredDistanceToPoint( FMath::Lerp( start, end, second_ratio ) );
+
+            if ( FMath::Min( first_distance, second_distance ) <= radius_squared )
+            {
+                return true;
+            }
+
+            if ( first_distance < second_distance )
+            {
+                max_ratio = second_ratio;
+            }
+            else
+            {
+                min_ratio = first_ratio;
+            }
+        }
+
+        return box.ComputeSquaredDistanceToPoint( FMath::Lerp( start, end, ( min_ratio + max_ratio ) * 0.5f ) ) <= radius_squared;
+    }
+}
+
+bool FSVOGeometrySnapshot::Gather( const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGeometrySnapshot_Gather );
+
+    check( IsInGameThread() );
+
+    Bounds = bounds;
+
+    TArray< FOverlapResult > overlap_results;
+
+    world.OverlapMultiByChannel( overlap_results,
+        bounds.GetCenter(),
+        FQuat::Identity,
+        generation_settings.CollisionChannel,
+        FCollisionShape::MakeBox( bounds.GetExtent() ),
+        generation_settings.CollisionQueryParameters );
+
+    const auto trace_complex = generation_settings.CollisionQueryParameters.bTraceComplex;
+
+    // A component can be returned once per body instance
+    TSet< TPair< const UPrimitiveComponent *, int32 > > gathered_items;
+
+    for ( const auto & overlap_result : overlap_results )
+    {
+        const auto * component = overlap_result.GetComponent();
+
+        if ( component == nullptr || !component->CanEverAffectNavigation() )
+        {
+            continue;
+        }
+
+        if ( const auto * instanced_static_mesh_component = Cast< UInstancedStaticMeshComponent >( component ) )
+        {
+            bool is_already_in_set;
+            gathered_items.Add( TPair< const UPrimitiveComponent *, int32 >( component, overlap_result.ItemIndex ), &is_already_in_set );
+
+            FTransform instance_transform;
+            if ( !is_already_in_set && instanced_static_mesh_component->GetInstanceTransform( overlap_result.ItemIndex, instance_transform, true ) && !AddComponent( *component, instance_transform, trace_complex ) )
+            {
+                UE_LOG( LogNavigation, Verbose, TEXT( "SVO geometry snapshot of %s : the collision of %s can't be copied" ), *bounds.ToString(), *component->GetPathName() );
+                return false;
+            }
+        }
+        else
+        {
+            bool is_already_in_set;
+            gathered_items.Add( TPair< const UPrimitiveComponent *, int32 >( component, INDEX_NONE ), &is_already_in_set );
+
+            if ( !is_already_in_set && !AddComponent( *component, component->GetComponentTransform(), trace_complex ) )
+            {
+                UE_LOG( LogNavigation, Verbose, TEXT( "SVO geometry snapshot of %s : the collision of %s can't be copied" ), *bounds.ToString(), *component->GetPathName() );
+                return false;
+            }
+        }
+    }
+
+    BuildBVH();
+
+    UE_LOG( LogNavigation, Verbose, TEXT( "SVO geometry snapshot of %s : %i components, %i primitives" ), *bounds.ToString(), gathered_items.Num(), Primitives.Num() );
+
+    return true;
+}
+
+bool FSVOGeometrySnapshot::IsBoxOccluded( const FBox & box ) const
+{
+    if ( BVHNodes.Num() == 0 )
+    {
+        return false;
+    }
+
+    TArray< int32, TInlineAllocator< 64 > > node_indices_to_visit;
+    node_indices_to_visit.Push( 0 );
+
+    while ( node_indices_to_visit.Num() > 0 )
+    {
+        const auto & node = BVHNodes[ node_indices_to_visit.Pop( false ) ];
+
+        if ( !node.Bounds.Intersect( box ) )
+        {
+            continue;
+        }
+
+        if ( node.PrimitiveCount == 0 )
+        {
+            node_indices_to_visit.Push( node.LeftChildIndex );
+            node_indices_to_visit.Push( node.RightChildIndex );
+            continue;
+        }
+
+        for ( auto index = node.FirstPrimitiveIndex; index < node.FirstPrimitiveIndex + node.PrimitiveCount; ++index )
+        {
+            const auto primitive_index = PrimitiveIndices[ index ];
+
+            if ( Primitives[ primitive_index ].Bounds.Intersect( box ) && IsBoxOccludedByPrimitive( box, primitive_index ) )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void FSVOGeometrySnapshot::GatherPrimitives( TArray< int32, TInlineAllocator< 64 > > & primitive_indices, const FBox & box ) const
+{
+    if ( BVHNodes.Num() == 0 )
+    {
+        return;
+    }
+
+    TArray< int32, TInlineAllocator< 64 > > node_indices_to_visit;
+    node_indices_to_visit.Push( 0 );
+
+    while ( node_indices_to_visit.Num() > 0 )
+    {
+        const auto & node = BVHNodes[ node_indices_to_visit.Pop( false ) ];
+
+        if ( !node.Bounds.Intersect( box ) )
+        {
+            continue;
+        }
+
+        if ( node.PrimitiveCount == 0 )
+        {
+            node_indices_to_visit.Push( node.LeftChildIndex );
+            node_indices_to_visit.Push( node.RightChildIndex );
+            continue;
+        }
+
+        for ( auto index = node.FirstPrimitiveIndex; index < node.FirstPrimitiveIndex + node.PrimitiveCount; ++index )
+        {
+            const auto primitive_index = PrimitiveIndices[ index ];
+
+            if ( Primitives[ primitive_index ].Bounds.Intersect( box ) )
+            {
+                primitive_indices.Add( primitive_index );
+            }
+        }
+    }
+}
+
+int FSVOGeometrySnapshot::GetAllocatedSize() const
+{
+    return Primitives.GetAllocatedSize()
+           + Parallelepipeds.GetAllocatedSize()
+           + Spheres.GetAllocatedSize()
+           + Capsules.GetAllocatedSize()
+           + Convexes.GetAllocatedSize()
+           + ConvexPlanes.GetAllocatedSize()
+           + Triangles.GetAllocatedSize()
+           + BVHNodes.GetAllocatedSize()
+           + PrimitiveIndices.GetAllocatedSize();
+}
+
+bool FSVOGeometrySnapshot::AddComponent( const UPrimitiveComponent & component, const FTransform & transform, const bool trace_complex )
+{
+    const auto * body_setup = component.GetBodySetup();
+
+    return body_setup != nullptr && AddBodySetup( *body_setup, transform, trace_complex );
+}
+
+bool FSVOGeometrySnapshot::AddBodySetup( const UBodySetup & body_setup, const FTransform & transform, const bool trace_complex )
+{
+    const auto collision_trace_flag = body_setup.GetCollisionTraceFlag();
+    const auto use_complex_collision = trace_complex
+                                           ? collision_trace_flag != CTF_UseSimpleAsComplex
+                                           : collision_trace_flag == CTF_UseComplexAsSimple;
+
+    if ( use_complex_collision )
+    {
+        auto * collision_data_provider = Cast< IInterface_CollisionDataProvider >( body_setup.GetOuter() );
+
+        if ( collision_data_provider == nullptr || !collision_data_provider->ContainsPhysicsTriMeshData( true ) )
+        {
+            return false;
+        }
+
+        FTriMeshCollisionData tri_mesh_collision_data;
+        if ( !collision_data_provider->GetPhysicsTriMeshData( &tri_mesh_collision_data, true ) )
+        {
+            return false;
+        }
+
+        for ( const auto & triangle_indices : tri_mesh_collision_data.Indices )
+        {
+            AddTriangle(
+                transform.TransformPosition( FVector( tri_mesh_collision_data.Vertices[ triangle_indices.v0 ] ) ),
+                transform.TransformPosition( FVector( tri_mesh_collision_data.Vertices[ triangle_indices.v1 ] ) ),
+                transform.TransformPosition( FVector( tri_mesh_collision_data.Vertices[ triangle_indices.v2 ] ) ) );
+        }
+
+        return true;
+    }
+
+    const auto & aggregate_geometry = body_setup.AggGeom;
+
+    if ( aggregate_geometry.GetElementCount() == 0 )
+    {
+        return false;
+    }
+
+    const auto scale = transform.GetScale3D();
+
+    for ( const auto & box_element : aggregate_geometry.BoxElems )
+    {
+        const auto rotation = box_element.Rotation.Quaternion();
+
+        AddParallelepiped(
+            transform.TransformPosition( box_element.Center ),
+            transform.TransformVector( rotation.GetAxisX() * box_element.X * 0.5f ),
+            transform.TransformVector( rotation.GetAxisY() * box_element.Y * 0.5f ),
+            transform.TransformVector( rotation.GetAxisZ() * box_element.Z * 0.5f ) );
+    }
+
+    for ( const auto & sphere_element : aggregate_geometry.SphereElems )
+    {
+        AddSphere( transform.TransformPosition( sphere_element.Center ), sphere_element.Radius * scale.GetAbsMin() );
+    }
+
+    const auto capsule_radius_scale = FMath::Max( FMath::Abs( scale.X ), FMath::Abs( scale.Y ) );
+
+    for ( const auto & sphyl_element : aggregate_geometry.SphylElems )
+    {
+        const auto half_segment = sphyl_element.Rotation.Quaternion().GetAxisZ() * sphyl_element.Length * 0.5f;
+
+        AddCapsule(
+            transform.TransformPosition( sphyl_element.Center + half_segment ),
+            transform.TransformPosition( sphyl_element.Center - half_segment ),
+            sphyl_element.Radius * capsule_radius_scale );
+    }
+
+    // Approximated by a capsule with the largest of the two radii
+    for ( const auto & tapered_capsule_element : aggregate_geometry.TaperedCapsuleElems )
+    {
+        const auto half_segment = tapered_capsule_element.Rotation.Quaternion().GetAxisZ() * tapered_capsule_element.Length * 0.5f;
+
+        AddCapsule(
+            transform.TransformPosition( tapered_capsule_element.Center + half_segment ),
+            transform.TransformPosition( tapered_capsule_element.Center - half_segment ),
+            FMath::Max( tapered_capsule_element.Radius0, tapered_capsule_element.Radius1 ) * capsule_radius_scale );
+    }
+
+    for ( const auto & convex_element : aggregate_geometry.ConvexElems )
+    {
+        const auto element_transform = convex_element.GetTransform() * transform;
+
+        TArray< FVector > vertices;
+        vertices.Reserve( convex_element.VertexData.Num() );
+
+        for ( const auto & vertex : convex_element.VertexData )
+        {
+            vertices.Emplace( element_transform.TransformPosition( vertex ) );
+        }
+
+        AddConvex( vertices, convex_element.IndexData );
+    }
+
+    return true;
+}
+
+void FSVOGeometrySnapshot::AddParallelepiped( const FVector & center, const FVector & half_axis_x, const FVector & half_axis_y, const FVector & half_axis_z )
+{
+    const auto extent = half_axis_x.GetAbs() + half_axis_y.GetAbs() + half_axis_z.GetAbs();
+
+    auto & parallelepiped = Parallelepipeds.AddDefaulted_GetRef();
+    parallelepiped.Center = center;
+    parallelepiped.HalfAxes[ 0 ] = half_axis_x;
+    parallelepiped.HalfAxes[ 1 ] = half_axis_y;
+    parallelepiped.HalfAxes[ 2 ] = half_axis_z;
+
+    AddPrimitive( FBox::BuildAABB( center, extent ), EPrimitiveType::Box, Parallelepipeds.Num() - 1 );
+}
+
+void FSVOGeometrySnapshot::AddSphere( const FVector & center, const float radius )
+{
+    Spheres.Add( { center, radius } );
+
+    AddPrimitive( FBox::BuildAABB( center, FVector( radius ) ), EPrimitiveType::Sphere, Spheres.Num() - 1 );
+}
+
+void FSVOGeometrySnapshot::AddCapsule( const FVector & start, const FVector & end, const float radius )
+{
+    Capsules.Add( { start, end, radius } );
+
+    const auto bounds = FBox( start.ComponentMin( end ), start.ComponentMax( end ) ).ExpandBy( radius );
+    AddPrimitive( bounds, EPrimitiveType::Capsule, Capsules.Num() - 1 );
+}
+
+void FSVOGeometrySnapshot::AddConvex( const TArray< FVector > & vertices, const TArray< int32 > & indices )
+{
+    if ( vertices.Num() == 0 )
+    {
+        return;
+    }
+
+    const FBox bounds( vertices );
+
+    // Without the hull triangles, we can only keep the bounds of the convex
+    if ( indices.Num() < 3 )
+    {
+        const auto extent = bounds.GetExtent();
+        AddParallelepiped( bounds.GetCenter(), FVector( extent.X, 0.0f, 0.0f ), FVector( 0.0f, extent.Y, 0.0f ), FVector( 0.0f, 0.0f, extent.Z ) );
+        return;
+    }
+
+    const auto centroid = bounds.GetCenter();
+
+    auto & convex = Convexes.AddDefaulted_GetRef();
+    convex.FirstPlaneIndex = ConvexPlanes.Num();
+
+    for ( auto index = 0; index + 2 < indices.Num(); index += 3 )
+    {
+        auto plane = FPlane( vertices[ indices[ index ] ], vertices[ indices[ index + 1 ] ], vertices[ indices[ index + 2 ] ] );
+
+        // Degenerated triangle
+        if ( plane.GetNormal().IsNearlyZero() )
+        {
+            continue;
+        }
+
+        // Make all the normals point outside of the hull
+        if ( plane.PlaneDot( centroid ) > 0.0f )
+        {
+            plane = plane.Flip();
+        }
+
+        ConvexPlanes.Add( plane );
+    }
+
+    convex.PlaneCount = ConvexPlanes.Num() - convex.FirstPlaneIndex;
+
+    AddPrimitive( bounds, EPrimitiveType::Convex, Convexes.Num() - 1 );
+}
+
+void FSVOGeometrySnapshot::AddTriangle( const FVector & a, const FVector & b, const FVector & c )
+{
+    const auto bounds = FBox( a.ComponentMin( b ).ComponentMin( c ), a.ComponentMax( b ).ComponentMax( c ) );
+
+    // Complex collisions can be huge. Only keep what we will query
+    if ( !bounds.Intersect( Bounds ) )
+    {
+        return;
+    }
+
+    auto & triangle = Triangles.AddDefaulted_GetRef();
+    triangle.Vertices[ 0 ] = a;
+    triangle.Vertices[ 1 ] = b;
+    triangle.Vertices[ 2 ] = c;
+
+    AddPrimitive( bounds, EPrimitiveType::Triangle, Triangles.Num() - 1 );
+}
+
+void FSVOGeometrySnapshot::AddPrimitive( const FBox & bounds, const EPrimitiveType type, const int32 data_index )
+{
+    auto & primitive = Primitives.AddDefaulted_GetRef();
+    primitive.Bounds = bounds;
+    primitive.Type = type;
+    primitive.DataIndex = data_index;
+}
+
+void FSVOGeometrySnapshot::BuildBVH()
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOGeometrySnapshot_BuildBVH );
+
+    BVHNodes.Reset();
+    PrimitiveIndices.Reset( Primitives.Num() );
+
+    if ( Primitives.Num() == 0 )
+    {
+        return;
+    }
+
+    for ( auto index = 0; index < Primitives.Num(); ++index )
+    {
+        PrimitiveIndices.Add( index );
+    }
+
+    BVHNodes.Reserve( 2 * FMath::DivideAndRoundUp( Primitives.Num(), MaxPrimitivesPerBVHLeaf ) );
+    BuildBVHNode( 0, Primitives.Num() );
+}
+
+int32 FSVOGeometrySnapshot::BuildBVHNode( const int32 first_primitive_index, const int32 primitive_count )
+{
+    const auto node_index = BVHNodes.AddDefaulted();
+
+    FBox node_bounds( ForceInit );
+    FBox centers_bounds( ForceInit );
+
+    for ( auto index = first_primitive_index; index < first_primitive_index + primitive_count; ++index )
+    {
+        const auto & primitive_bounds = Primitives[ PrimitiveIndices[ index ] ].Bounds;
+        node_bounds += primitive_bounds;
+        centers_bounds += primitive_bounds.GetCenter();
+    }
+
+    BVHNodes[ node_index ].Bounds = node_bounds;
+
+    if ( primitive_count <= MaxPrimitivesPerBVHLeaf )
+    {
+        BVHNodes[ node_index ].FirstPrimitiveIndex = first_primitive_index;
+        BVHNodes[ node_index ].PrimitiveCount = primitive_count;
+        return node_index;
+    }
+
+    // Median split along the largest axis of the centers of the primitives
+    const auto centers_size = centers_bounds.GetSize();
+    const auto split_axis = centers_size.X >= centers_size.Y && centers_size.X >= centers_size.Z
+                                ? 0
+                                : ( centers_size.Y >= centers_size.Z ? 1 : 2 );
+
+    Algo::Sort( MakeArrayView( PrimitiveIndices.GetData() + first_primitive_index, primitive_count ), [ this, split_axis ]( const int32 left, const int32 right ) {
+        return Primitives[ left ].Bounds.GetCenter()[ split_axis ] < Primitives[ right ].Bounds.GetCenter()[ split_axis ];
+    } );
+
+    const auto left_primitive_count = primitive_count / 2;
+    const auto left_child_index = BuildBVHNode( first_primitive_index, left_primitive_count );
+    const auto right_child_index = BuildBVHNode( first_primitive_index + left_primitive_count, primitive_count - left_primitive_count );
+
+    auto & node = BVHNodes[ node_index ];
+    node.LeftChildIndex = left_child_index;
+    node.RightChildIndex = right_child_index;
+    node.FirstPrimitiveIndex = INDEX_NONE;
+    node.PrimitiveCount = 0;
+
+    return node_index;
+}
+
+bool FSVOGeometrySnapshot::IsBoxOccludedByPrimitive( const FBox & box, const int32 primitive_index ) const
+{
+    const auto & primitive = Primitives[ primitive_index ];
+
+    switch ( primitive.Type )
+    {
+        case EPrimitiveType::Box:
+        {
+            const auto & parallelepiped = Parallelepipeds[ primitive.DataIndex ];
+            return DoesBoxIntersectParallelepiped( box.GetCenter(), box.GetExtent(), parallelepiped.Center, parallelepiped.HalfAxes );
+        }
+        case EPrimitiveType::Sphere:
+        {
+            const auto & sphere = Spheres[ primitive.DataIndex ];
+            return FMath::SphereAABBIntersection( sphere.Center, FMath::Square( sphere.Radius ), box );
+        }
+        case EPrimitiveType::Capsule:
+        {
+            const auto & capsule = Capsules[ primitive.DataIndex ];
+            return DoesBoxIntersectCapsule( box, capsule.Start, capsule.End, capsule.Radius );
+        }
+        case EPrimitiveType::Convex:
+        {
+            // The box axes are already tested with the bounds of the convex. Edge / edge axes are skipped, which keeps the test conservative
+            const auto & convex = Convexes[ primitive.DataIndex ];
+            const auto box_center = box.GetCenter();
+            const auto box_extent = box.GetExtent();
+
+            for ( auto index = convex.FirstPlaneIndex; index < convex.FirstPlaneIndex + convex.PlaneCount; ++index )
+            {
+                const auto & plane = ConvexPlanes[ index ];
+                const auto box_radius = box_extent.X * FMath::Abs( plane.X ) + box_extent.Y * FMath::Abs( plane.Y ) + box_extent.Z * FMath::Abs( plane.Z );
+
+                if ( plane.PlaneDot( box_center ) > box_radius )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        case EPrimitiveType::Triangle:
+        {
+            return DoesBoxIntersectTriangle( box.GetCenter(), box.GetExtent(), Triangles[ primitive.DataIndex ].Vertices );
+        }
+        default:
+        {
+            checkNoEntry();
+            return false;
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#include "SVOMemoryReport.h"
+
+#include "SVONavigationData.h"
+#include "SVONavigationDataChunk.h"
+#include "SVONavigationStats.h"
+#include "SVOVolumeNavigationData.h"
+
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+
+#include <atomic>
+
+namespace
+{
+    std::atomic< int64 > LargestPathFindingNodePoolSize( 0 );
+
+    void DumpMemoryReports( const TArray< FString > & arguments, UWorld * world )
+    {
+        if ( world == nullptr )
+        {
+            return;
+        }
+
+        const auto log_layers = arguments.ContainsByPredicate( []( const FString & argument ) {
+            return argument.Equals( TEXT( "Layers" ), ESearchCase::IgnoreCase );
+        } );
+
+        int64 total_size = 0;
+
+        for ( TActorIterator< ASVONavigationData > iterator( world ); iterator; ++iterator )
+        {
+            const auto * navigation_data = *iterator;
+            const auto report = FSVONavigationDataMemoryReport::Make( *navigation_data );
+
+            UE_LOG( LogNavigation, Display, TEXT( "%s : %s" ), *navigation_data->GetName(), *report.ToString() );
+
+            for ( const auto & volume_report : report.Volumes )
+            {
+                UE_LOG( LogNavigation, Display, TEXT( "    %s" ), *volume_report.ToString() );
+
+                if ( !log_layers )
+                {
+                    continue;
+                }
+
+                for ( auto layer_index = 0; layer_index < volume_report.Layers.Num(); ++layer_index )
+                {
+                    UE_LOG( LogNavigation, Display, TEXT( "        Layer %d - %s" ), layer_index, *volume_report.Layers[ layer_index ].ToString() );
+                }
+            }
+
+            total_size += report.GetAllocatedSize();
+        }
+
+        UE_LOG( LogNavigation, Display, TEXT( "SVO navigation data total %.2fKB - Largest path finding node pool %.2fKB" ), total_size / 1024.0f, FSVONavigationDataMemoryReport::GetLargestPathFindingNodePoolSize() / 1024.0f );
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs DumpMemoryReportsCommand(
+        TEXT( "SVONavigation.DumpMemory" ),
+        TEXT( "Logs the memory used by each volume of the SVO navigation data, and by the navigation data chunks of the loaded levels. Add Layers to also log the arrays of each layer." ),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic( &DumpMemoryReports ) );
+}
+
+FSVOLayerMemoryReport::FSVOLayerMemoryReport() :
+    NodeCount( 0 ),
+    MortonCodesSize( 0 ),
+    FirstChildrenSize( 0 ),
+    NeighborsSize( 0 ),
+    ParentsSize( 0 ),
+    MortonCodeIndexSize( 0 ),
+    SlackSize( 0 )
+{
+}
+
+int64 FSVOLayerMemoryReport::GetAllocatedSize() const
+{
+    return MortonCodesSize + FirstChildrenSize + NeighborsSize + ParentsSize + MortonCodeIndexSize;
+}
+
+FString FSVOLayerMemoryReport::ToString() const
+{
+    return FString::Printf( TEXT( "%d nodes - Morton codes %.2fKB, first children %.2fKB, neighbors %.2fKB, parents %.2fKB, morton code index %.2fKB - Slack %.2fKB" ),
+        NodeCount,
+        MortonCodesSize / 1024.0f,
+        FirstChildrenSize / 1024.0f,
+        NeighborsSize / 1024.0f,
+        ParentsSize / 1024.0f,
+        MortonCodeIndexSize / 1024.0f,
+        SlackSize / 1024.0f );
+}
+
+FSVOVolumeMemoryReport::FSVOVolumeMemoryReport() :
+    VolumeBounds( ForceInit ),
+    bIsInNavigationDataChunk( false ),
+    LeafNodesSize( 0 ),
+    DataSize( 0 ),
+    DynamicObstaclesSize( 0 )
+{
+}
+
+FSVOVolumeMemoryReport FSVOVolumeMemoryReport::Make( const FSVOVolumeNavigationData & volume_navigation_data )
+{
+    const auto & data = volume_navigation_data.GetData();
+
+    FSVOVolumeMemoryReport report;
+    report.VolumeBounds = volume_navigation_data.GetVolumeBounds();
+    report.bIsInNavigationDataChunk = volume_navigation_data.IsInNavigationDataChunk();
+    report.LeafNodesSize = data.GetLeafNodes().GetAllocatedSize();
+    report.DataSize = data.GetAllocatedSize();
+    report.DynamicObstaclesSize = volume_navigation_data.GetDynamicObstacles().GetAllocatedSize();
+
+    report.Layers.Reserve( data.GetLayerCount() );
+
+    for ( LayerIndex layer_index = 0; layer_index < data.GetLayerCount(); ++layer_index )
+    {
+        report.Layers.Emplace( data.GetLayer( layer_index ).GetMemoryReport() );
+    }
+
+    return report;
+}
+
+int64 FSVOVolumeMemoryReport::GetAllocatedSize() const
+{
+    return DataSize + DynamicObstaclesSize;
+}
+
+FString FSVOVolumeMemoryReport::ToString() const
+{
+    int64 slack_size = 0;
+
+    for ( const auto & layer : Layers )
+    {
+        slack_size += layer.SlackSize;
+    }
+
+    return FString::Printf( TEXT( "Volume %s%s - %d layers - Total %.2fKB - Leaf nodes %.2fKB, dynamic obstacles %.2fKB - Slack %.2fKB" ),
+        *VolumeBounds.ToString(),
+        bIsInNavigationDataChunk ? TEXT( " (chunk)" ) : TEXT( "" ),
+        Layers.Num(),
+        GetAllocatedSize() / 1024.0f,
+        LeafNodesSize / 1024.0f,
+        DynamicObstaclesSize / 1024.0f,
+        slack_size / 1024.0f );
+}
+
+FSVONavigationDataMemoryReport::FSVONavigationDataMemoryReport() :
+    ChunkVolumeCount( 0 ),
+    ChunksSize( 0 )
+{
+}
+
+FSVONavigationDataMemoryReport FSVONavigationDataMemoryReport::Make( const ASVONavigationData & navigation_data )
+{
+    check( IsInGameThread() );
+
+    FSVONavigationDataMemoryReport report;
+
+    // The copies of a volume share the same octree
+    TSet< const FSVOData * > counted_data;
+
+    for ( const auto & volume_navigation_data : navigation_data.GetVolumeNavigationData() )
+    {
+        report.Volumes.Emplace( FSVOVolumeMemoryReport::Make( volume_navigation_data ) );
+        counted_data.Add( &volume_navigation_data.GetData() );
+    }
+
+    if ( const auto * world = navigation_data.GetWorld() )
+    {
+        for ( auto * level : world->GetLevels() )
+        {
+            const auto * navigation_data_chunk = level != nullptr ? navigation_data.GetNavigationDataChunk( level ) : nullptr;
+
+            if ( navigation_data_chunk == nullptr )
+            {
+                continue;
+            }
+
+            report.ChunksSize += navigation_data_chunk->NavigationData.GetAllocatedSize();
+
+            for ( const auto & volume_navigation_data : navigation_data_chunk->NavigationData )
+            {
+                report.ChunkVolumeCount++;
+
+                bool is_already_in_set;
+                counted_data.Add( &volume_navigation_data.GetData(), &is_already_in_set );
+
+                if ( !is_already_in_set )
+                {
+                    report.ChunksSize += volume_navigation_data.GetData().GetAllocatedSize();
+                }
+            }
+        }
+    }
+
+    return report;
+}
+
+void FSVONavigationDataMemoryReport::AddPathFindingNodePool( const int64 allocated_size )
+{
+    auto largest_size = LargestPathFindingNodePoolSize.load( std::memory_order_relaxed );
+
+    while ( allocated_size > largest_size )
+    {
+        if ( LargestPathFindingNodePoolSize.compare_exchange_weak( largest_size, allocated_size, std::memory_order_relaxed ) )
+        {
+            SET_MEMORY_STAT( STAT_SVONavigation_PathFindingNodePoolMemory, allocated_size );
+            break;
+        }
+    }
+}
+
+int64 FSVONavigationDataMemoryReport::GetLargestPathFindingNodePoolSize()
+{
+    return LargestPathFindingNodePoolSize.load( std::memory_order_relaxed );
+}
+
+int64 FSVONavigationDataMemoryReport::GetAllocatedSize() const
+{
+    auto size = ChunksSize;
+
+    for ( const auto & volume : Volumes )
+    {
+        size += volume.GetAllocatedSize();
+    }
+
+    return size;
+}
+
+FString FSVONavigationDataMemoryReport::ToString() const
+{
+    return FString::Printf( TEXT( "%d volumes - Total %.2fKB - %d volumes in the navigation data chunks, %.2fKB not shared with the volumes" ),
+        Volumes.Num(),
+        GetAllocatedSize() / 1024.0f,
+        ChunkVolumeCount,
+        ChunksSize / 1024.0f );
+}
@@ -77,15 +77,17 @@ FSVONavigationMeshSceneProxy::FSVONavigationMeshSceneProxy( const UPrimitiveComp
             const auto corrected_layer_index = FMath::Clamp( static_cast< int >( debug_infos.LayerIndexToDraw ), 0, layer_count - 1 );
             const auto node_extent = navigation_bounds_data.GetData().GetLayer( corrected_layer_index ).GetNodeExtent();
 
-            for ( const auto & node : octree_data.GetLayer( corrected_layer_index ).GetNodes() )
+            const auto & layer = octree_data.GetLayer( corrected_layer_index );
+
+            for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( layer.GetNodeCount() ); ++node_index )
             {
-                const auto code = node.MortonCode;
+                const auto code = layer.GetNodeMortonCode( node_index );
 
                 if ( corrected_layer_index == 0 )
                 {
                     const auto leaf_node_position = navigation_bounds_data.GetLeafNodePositionFromMortonCode( code );
 
-                    if ( AddVoxelToBoxes( leaf_node_position, leaf_node_extent, node.HasChildren() ) )
+                    if ( AddVoxelToBoxes( leaf_node_position, leaf_node_extent, layer.HasNodeChildren( node_index ) ) )
                     {
                         AddNodeTextInfos( code, 0, leaf_node_position );
                     }
@@ -94,7 +96,7 @@ FSVONavigationMeshSceneProxy::FSVONavigationMeshSceneProxy( const UPrimitiveComp
                 {
                     const auto position = navigation_bounds_data.GetNodePositionFromLayerAndMortonCode( corrected_layer_index, code );
 
-                    if ( AddVoxelToBoxes( position, node_extent, node.HasChildren() ) )
+                    if ( AddVoxelToBoxes( position, node_extent, layer.HasNodeChildren( node_index ) ) )
                     {
                         AddNodeTextInfos( code, corrected_layer_index, position );
                     }
@@ -108,12 +110,12 @@ FSVONavigationMeshSceneProxy::FSVONavigationMeshSceneProxy( const UPrimitiveComp
             const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
             const auto leaf_sub_node_extent = leaf_nodes.GetLeafSubNodeExtent();
 
-            for ( const auto & leaf_node : leaf_layer.GetNodes() )
+            for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( leaf_layer.GetNodeCount() ); ++node_index )
             {
-                if ( leaf_node.HasChildren() )
+                if ( leaf_layer.HasNodeChildren( node_index ) )
                 {
-                    const auto & leaf = octree_data.GetLeafNodes().GetLeafNode( leaf_node.FirstChild.NodeIndex );
-                    const auto code = leaf_node.MortonCode;
+                    const auto & leaf = octree_data.GetLeafNodes().GetLeafNode( leaf_layer.GetNodeFirstChild( node_index ).NodeIndex );
+                    const auto code = leaf_layer.GetNodeMortonCode( node_index );
                     const auto leaf_node_position = navigation_bounds_data.GetLeafNodePositionFromMortonCode( code );
 
                     for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; sub_node_index++ )
@@ -1,5 +1,21 @@
 #include "SVONavigation.h"
 
+#include "SVONavigationStats.h"
+
+DEFINE_STAT( STAT_SVONavigation_GenerateVolume );
+DEFINE_STAT( STAT_SVONavigation_UpdateVolume );
+DEFINE_STAT( STAT_SVONavigation_FirstPassRasterization );
+DEFINE_STAT( STAT_SVONavigation_LeafRasterization );
+DEFINE_STAT( STAT_SVONavigation_Layers );
+DEFINE_STAT( STAT_SVONavigation_NeighborLinks );
+DEFINE_STAT( STAT_SVONavigation_OverlapQueries );
+DEFINE_STAT( STAT_SVONavigation_GeneratedVolumes );
+DEFINE_STAT( STAT_SVONavigation_VolumesMemory );
+DEFINE_STAT( STAT_SVONavigation_ChunksMemory );
+DEFINE_STAT( STAT_SVONavigation_PathFindingNodePoolMemory );
+
+LLM_DEFINE_TAG( SVONavigation );
+
 #define LOCTEXT_NAMESPACE "FSVONavigationModule"
 
 void FSVONavigationModule::StartupModule()
@@ -6,13 +6,16 @@
 #include "SVOBoundsVolume.h"
 #include "SVONavDataRenderingComponent.h"
 #include "SVONavigationDataChunk.h"
+#include "SVOMemoryReport.h"
 #include "SVONavigationDataGenerator.h"
 #include "SVONavigationSettings.h"
+#include "SVONavigationStats.h"
 #include "SVOVersion.h"
 
 #include <AI/NavDataGenerator.h>
 #include <DrawDebugHelpers.h>
 #include <EngineUtils.h>
+#include <Misc/ScopeRWLock.h>
 #include <NavMesh/NavMeshPath.h>
 #include <NavigationSystem.h>
 
@@ -40,6 +43,12 @@ ASVONavigationData::ASVONavigationData() :
     Version( ESVOVersion::Latest )
 {
     MaxSimultaneousBoxGenerationJobsCount = 1024;
+    RuntimeGenerationTimeBudget = 0.0f;
+    RuntimeGenerationTargetFrameTime = 0.0f;
+    NextDynamicObstacleId = 0;
+    ReportedVolumesMemorySize = 0;
+    ReportedChunksMemorySize = 0;
+    bMemoryStatsNeedUpdate = true;
 
     if ( !HasAnyFlags( RF_ClassDefaultObject ) )
     {
@@ -138,6 +147,8 @@ void ASVONavigationData::Serialize( FArchive & archive )
             archive.Seek( svo_size_position + svo_size_bytes );
             // if it's not getting filled it's better to just remove it
             VolumeNavigationData.Reset();
+            UpdateVolumeSerials();
+            RequestMemoryStatsUpdate();
         }
     }
     else
@@ -158,6 +169,7 @@ void ASVONavigationData::CleanUp()
 {
     Super::CleanUp();
     ResetGenerator();
+    ResetMemoryStats();
 }
 
 bool ASVONavigationData::NeedsRebuild() const
@@ -186,8 +198,7 @@ void ASVONavigationData::EnsureBuildCompletion()
 
 bool ASVONavigationData::SupportsRuntimeGeneration() const
 {
-    // :TODO:
-    return false;
+    return RuntimeGeneration == ERuntimeGenerationType::Dynamic;
 }
 
 bool ASVONavigationData::SupportsStreaming() const
@@ -226,7 +237,7 @@ FNavLocation ASVONavigationData::GetRandomPoint( FSharedConstNavQueryFilter /*fi
         const auto index = navigation_bounds_indices.Pop( false );
         const auto & volume_navigation_data = VolumeNavigationData[ index ];
 
-        const auto random_point = volume_navigation_data.GetRandomPoint();
+        const auto random_point = volume_navigation_data.GetRandomPoint( index );
         if ( random_point.IsSet() )
         {
             result = random_point.GetValue();
@@ -305,16 +316,16 @@ ENavigationQueryResult::Type ASVONavigationData::CalcPathLengthAndCost( const FV
         return ENavigationQueryResult::Success;
     }
 
-    auto * volume_navigation_data = GetVolumeNavigationDataContainingPoints( { path_start, path_end } );
+    const auto volume_navigation_data = CopyVolumeNavigationDataContainingPoints( { path_start, path_end } );
 
-    if ( volume_navigation_data == nullptr )
+    if ( !volume_navigation_data.IsSet() )
     {
         return ENavigationQueryResult::Error;
     }
 
     const TSharedRef< FSVONavigationPath > navigation_path = MakeShareable( new FSVONavigationPath() );
 
-    result = FSVOPathFinder::GetPath( navigation_path.Get(), *this, path_start, path_end, filter );
+    result = FSVOPathFinder::GetPath( navigation_path.Get(), *this, volume_navigation_data.GetValue(), path_start, path_end, filter );
 
     if ( result == ENavigationQueryResult::Success || ( result == ENavigationQueryResult::Fail && navigation_path->IsPartial() ) )
     {
@@ -327,9 +338,18 @@ ENavigationQueryResult::Type ASVONavigationData::CalcPathLengthAndCost( const FV
 
 bool ASVONavigationData::DoesNodeContainLocation( NavNodeRef node_ref, const FVector & world_space_location ) const
 {
-    // :TODO:
-    ensure( false );
-    return false;
+    FSVONodeAddress node_address;
+    const auto volume_navigation_data = CopyVolumeNavigationDataFromNodeRef( node_address, node_ref );
+
+    if ( !volume_navigation_data.IsSet() )
+    {
+        return false;
+    }
+
+    const auto node_position = volume_navigation_data->GetNodePositionFromAddress( node_address, true );
+    const auto node_extent = volume_navigation_data->GetNodeExtentFromNodeAddress( node_address );
+
+    return FBox::BuildAABB( node_position, FVector( node_extent ) ).IsInsideOrOn( world_space_location );
 }
 
 UPrimitiveComponent * ASVONavigationData::ConstructRenderingComponent()
@@ -345,17 +365,27 @@ void ASVONavigationData::OnStreamingLevelAdded( ULevel * level, UWorld * /*world
     {
         if ( USVONavigationDataChunk * navigation_data_chunk = GetNavigationDataChunk( level ) )
         {
+            // The obstacles are rasterized before taking the lock. Only the game thread modifies the volumes, so they can be read without it
+            TArray< FSVOVolumeNavigationData > added_volumes;
+
             for ( const auto & chunk_nav_data : navigation_data_chunk->NavigationData )
             {
                 if ( VolumeNavigationData.FindByPredicate( [ &chunk_nav_data ]( const auto & navigation_data ) {
                          return chunk_nav_data.GetVolumeBounds() == navigation_data.GetVolumeBounds();
                      } ) == nullptr )
                 {
-                    VolumeNavigationData.Add( chunk_nav_data );
+                    RegisterDynamicObstacles( added_volumes.Add_GetRef( chunk_nav_data ) );
                 }
             }
 
+            {
+                FWriteScopeLock write_lock( VolumeNavigationDataLock );
+                VolumeNavigationData.Append( MoveTemp( added_volumes ) );
+                UpdateVolumeSerials();
+            }
+
             RequestDrawingUpdate();
+            RequestMemoryStatsUpdate();
         }
     }
 }
@@ -368,6 +398,8 @@ void ASVONavigationData::OnStreamingLevelRemoved( ULevel * level, UWorld * /*wor
     {
         if ( USVONavigationDataChunk * navigation_data_chunk = GetNavigationDataChunk( level ) )
         {
+            FWriteScopeLock write_lock( VolumeNavigationDataLock );
+
             for ( const auto & chunk_nav_data : navigation_data_chunk->NavigationData )
             {
                 VolumeNavigationData.RemoveAllSwap( [ &chunk_nav_data ]( const auto & nav_data ) {
@@ -375,7 +407,10 @@ void ASVONavigationData::OnStreamingLevelRemoved( ULevel * level, UWorld * /*wor
                 } );
             }
 
+            UpdateVolumeSerials();
+
             RequestDrawingUpdate();
+            RequestMemoryStatsUpdate();
         }
     }
 }
@@ -402,13 +437,16 @@ int32 ASVONavigationData::GetMaxSupportedAreas() const
 
 bool ASVONavigationData::IsNodeRefValid( const NavNodeRef node_ref ) const
 {
-    return FSVONodeAddress( node_ref ).IsValid();
+    FSVONodeAddress node_address;
+    return CopyVolumeNavigationDataFromNodeRef( node_address, node_ref ).IsSet();
 }
 
 void ASVONavigationData::TickActor( const float delta_time, const ELevelTick tick, FActorTickFunction & this_tick_function )
 {
     Super::TickActor( delta_time, tick, this_tick_function );
 
+    UpdateMemoryStats();
+
 #if ENABLE_DRAW_DEBUG
 
     if ( bEnableDrawing && DebugInfos.bDebugDrawActivePaths )
@@ -480,14 +518,7 @@ bool ASVONavigationData::ShouldExport()
 uint32 ASVONavigationData::LogMemUsed() const
 {
     const auto super_mem_used = Super::LogMemUsed();
-
-    auto navigation_mem_size = 0;
-    for ( const auto & nav_bounds_data : VolumeNavigationData )
-    {
-        const auto octree_data_mem_size = nav_bounds_data.GetData().GetAllocatedSize();
-        navigation_mem_size += octree_data_mem_size;
-    }
-    const auto mem_used = super_mem_used + navigation_mem_size;
+    const auto mem_used = super_mem_used + static_cast< uint32 >( FSVONavigationDataMemoryReport::Make( *this ).GetAllocatedSize() );
 
     UE_LOG( LogNavigation, Warning, TEXT( "%s: ASVONavigationData: %u\n    self: %d" ), *GetName(), mem_used, sizeof( ASVONavigationData ) );
 
@@ -555,9 +586,32 @@ FBox ASVONavigationData::GetBoundingBox() const
 
 void ASVONavigationData::RemoveDataInBounds( const FBox & bounds )
 {
+    FWriteScopeLock write_lock( VolumeNavigationDataLock );
+
     VolumeNavigationData.RemoveAllSwap( [ &bounds ]( const FSVOVolumeNavigationData & data ) {
         return data.GetVolumeBounds() == bounds;
     } );
+    UpdateVolumeSerials();
+
+    GenerationReports.RemoveAllSwap( [ &bounds ]( const FSVOGenerationReport & report ) {
+        return report.VolumeBounds == bounds;
+    } );
+
+    RequestMemoryStatsUpdate();
+}
+
+void ASVONavigationData::AddGenerationReport( const FSVOGenerationReport & report )
+{
+    if ( auto * existing_report = GenerationReports.FindByPredicate( [ &report ]( const FSVOGenerationReport & other_report ) {
+             return other_report.VolumeBounds == report.VolumeBounds;
+         } ) )
+    {
+        *existing_report = report;
+    }
+    else
+    {
+        GenerationReports.Add( report );
+    }
 }
 
 void ASVONavigationData::AddVolumeNavigationData( FSVOVolumeNavigationData data )
@@ -573,7 +627,87 @@ void ASVONavigationData::AddVolumeNavigationData( FSVOVolumeNavigationData data
         }
     }
 
-    VolumeNavigationData.Emplace( MoveTemp( data ) );
+    RegisterDynamicObstacles( data );
+
+    // The previous data of the volume is released once the lock is released, so the path queries waiting for the lock are not blocked by the deallocation
+    FSVOVolumeNavigationData previous_data;
+
+    {
+        FWriteScopeLock write_lock( VolumeNavigationDataLock );
+
+        // Replace the data of an updated volume in one go, so queries never see the volume without navigation data
+        if ( auto * existing_data = VolumeNavigationData.FindByPredicate( [ &data ]( const FSVOVolumeNavigationData & volume_navigation_data ) {
+                 return volume_navigation_data.GetVolumeBounds() == data.GetVolumeBounds();
+             } ) )
+        {
+            previous_data = MoveTemp( *existing_data );
+            *existing_data = MoveTemp( data );
+        }
+        else
+        {
+            VolumeNavigationData.Emplace( MoveTemp( data ) );
+        }
+
+        UpdateVolumeSerials();
+    }
+
+    RequestMemoryStatsUpdate();
+}
+
+int32 ASVONavigationData::AddDynamicObstacleBox( const FBox & box )
+{
+    return AddDynamicObstacle( FSVODynamicObstacle::MakeBox( box ) );
+}
+
+int32 ASVONavigationData::AddDynamicObstacleSphere( const FVector & center, const float radius )
+{
+    return AddDynamicObstacle( FSVODynamicObstacle::MakeSphere( center, radius ) );
+}
+
+bool ASVONavigationData::RemoveDynamicObstacle( const int32 obstacle_id )
+{
+    if ( DynamicObstacles.Remove( obstacle_id ) == 0 )
+    {
+        return false;
+    }
+
+    UpdateVolumesDynamicObstacles( [ obstacle_id ]( FSVOVolumeNavigationData & data ) {
+        return data.RemoveDynamicObstacle( obstacle_id );
+    } );
+
+    // Removing an obstacle doesn't invalidate the active paths, they only stop being the shortest ones
+    RequestDrawingUpdate();
+    return true;
+}
+
+TOptional< FSVOVolumeNavigationData > ASVONavigationData::CopyVolumeNavigationDataFromNodeRef( FSVONodeAddress & node_address, const NavNodeRef node_ref ) const
+{
+    const auto volume_index = FSVONodeAddress::GetVolumeIndexFromNavNodeRef( node_ref );
+
+    // The references are handed out by GetNodeAddressesFromPositions, which can be called from any thread
+    FReadScopeLock read_lock( VolumeNavigationDataLock );
+
+    if ( !VolumeNavigationData.IsValidIndex( volume_index ) )
+    {
+        return TOptional< FSVOVolumeNavigationData >();
+    }
+
+    const auto & volume_navigation_data = VolumeNavigationData[ volume_index ];
+
+    // The volume was generated again since the reference was built, or the volume with that index was removed and another one took its place
+    if ( !FSVONodeAddress::DoesNavNodeRefMatchVolumeSerial( node_ref, volume_navigation_data.GetSerial() ) )
+    {
+        return TOptional< FSVOVolumeNavigationData >();
+    }
+
+    node_address = FSVONodeAddress( node_ref );
+
+    if ( !volume_navigation_data.GetData().IsValid() || !volume_navigation_data.ContainsNodeAddress( node_address ) )
+    {
+        return TOptional< FSVOVolumeNavigationData >();
+    }
+
+    return volume_navigation_data;
 }
 
 const FSVOVolumeNavigationData * ASVONavigationData::GetVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const
@@ -591,6 +725,117 @@ const FSVOVolumeNavigationData * ASVONavigationData::GetVolumeNavigationDataCont
     } );
 }
 
+TOptional< FSVOVolumeNavigationData > ASVONavigationData::CopyVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const
+{
+    FReadScopeLock read_lock( VolumeNavigationDataLock );
+
+    if ( const auto * volume_navigation_data = GetVolumeNavigationDataContainingPoints( points ) )
+    {
+        return *volume_navigation_data;
+    }
+
+    return TOptional< FSVOVolumeNavigationData >();
+}
+
+void ASVONavigationData::GetNodeAddressesFromPositions( TArray< FSVONodeAddressFromPosition > & results, const TArray< FVector > & positions ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVONavigationData_GetNodeAddressesFromPositions );
+
+    results.Reset( positions.Num() );
+    results.SetNum( positions.Num() );
+
+    // The copies share the octrees, so the searches don't hold the lock while the game thread replaces the volumes
+    TArray< FSVOVolumeNavigationData > volume_navigation_data;
+    TArray< int32 > position_volume_indices;
+    position_volume_indices.SetNumUninitialized( positions.Num() );
+
+    {
+        FReadScopeLock read_lock( VolumeNavigationDataLock );
+
+        volume_navigation_data = VolumeNavigationData;
+
+        for ( auto position_index = 0; position_index < positions.Num(); ++position_index )
+        {
+            position_volume_indices[ position_index ] = VolumeNavigationData.IndexOfByPredicate( [ &position = positions[ position_index ] ]( const FSVOVolumeNavigationData & data ) {
+                return data.GetData().GetNavigationBounds().IsInside( position );
+            } );
+        }
+    }
+
+    const auto volume_count = volume_navigation_data.Num();
+
+    // Counting sort of the positions by volume : volume_offsets[ i ] is the first entry of the volume i in sorted_position_indices
+    TArray< int32 > volume_offsets;
+    volume_offsets.SetNumZeroed( volume_count + 1 );
+
+    for ( const auto volume_index : position_volume_indices )
+    {
+        if ( volume_index != INDEX_NONE )
+        {
+            ++volume_offsets[ volume_index + 1 ];
+        }
+    }
+
+    for ( auto volume_index = 0; volume_index < volume_count; ++volume_index )
+    {
+        volume_offsets[ volume_index + 1 ] += volume_offsets[ volume_index ];
+    }
+
+    TArray< int32 > sorted_position_indices;
+    sorted_position_indices.SetNumUninitialized( volume_offsets[ volume_count ] );
+
+    {
+        auto insert_offsets = volume_offsets;
+
+        for ( auto position_index = 0; position_index < positions.Num(); ++position_index )
+        {
+            const auto volume_index = position_volume_indices[ position_index ];
+
+            if ( volume_index != INDEX_NONE )
+            {
+                sorted_position_indices[ insert_offsets[ volume_index ]++ ] = position_index;
+            }
+        }
+    }
+
+    TArray< FVector > volume_positions;
+    TArray< FSVONodeAddressFromPosition > volume_results;
+
+    // Each volume sorts and searches its positions in one batch
+    for ( auto volume_index = 0; volume_index < volume_count; ++volume_index )
+    {
+        const auto first_index = volume_offsets[ volume_index ];
+        const auto last_index = volume_offsets[ volume_index + 1 ];
+
+        if ( first_index == last_index )
+        {
+            continue;
+        }
+
+        volume_positions.Reset( last_index - first_index );
+
+        for ( auto sorted_index = first_index; sorted_index < last_index; ++sorted_index )
+        {
+            volume_positions.Add( positions[ sorted_position_indices[ sorted_index ] ] );
+        }
+
+        const auto & data = volume_navigation_data[ volume_index ];
+        data.GetNodeAddressesFromPositions( volume_results, volume_positions );
+
+        for ( auto result_index = 0; result_index < volume_results.Num(); ++result_index )
+        {
+            auto & result = results[ sorted_position_indices[ first_index + result_index ] ];
+            result = volume_results[ result_index ];
+            result.VolumeIndex = volume_index;
+
+            if ( result.NodeAddress.IsValid() )
+            {
+                result.NodeRef = data.GetNavNodeRef( result.NodeAddress, volume_index );
+            }
+        }
+    }
+}
+
 void ASVONavigationData::UpdateNavVersion()
 {
     Version = ESVOVersion::Latest;
@@ -609,6 +854,9 @@ void ASVONavigationData::SerializeSVOData( FArchive & archive, ESVOVersion versi
         {
             VolumeNavigationData[ index ].Serialize( archive, Version );
         }
+
+        UpdateVolumeSerials();
+        RequestMemoryStatsUpdate();
     }
     else
     {
@@ -715,10 +963,141 @@ void ASVONavigationData::OnNavigationDataUpdatedInBounds( const TArray< FBox > &
     InvalidateAffectedPaths( updated_bounds );
 }
 
+int32 ASVONavigationData::AddDynamicObstacle( const FSVODynamicObstacle & obstacle )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVONavigationData_AddDynamicObstacle );
+
+    const auto obstacle_id = NextDynamicObstacleId++;
+    DynamicObstacles.Add( obstacle_id, obstacle );
+
+    UpdateVolumesDynamicObstacles( [ obstacle_id, &obstacle ]( FSVOVolumeNavigationData & data ) {
+        if ( !data.GetNavigationBounds().Intersect( obstacle.Bounds ) )
+        {
+            return false;
+        }
+
+        data.AddDynamicObstacle( obstacle_id, obstacle );
+        return true;
+    } );
+
+    InvalidatePathsCrossingObstacle( obstacle );
+    RequestDrawingUpdate();
+
+    return obstacle_id;
+}
+
+void ASVONavigationData::UpdateVolumesDynamicObstacles( TFunctionRef< bool( FSVOVolumeNavigationData & ) > update_volume )
+{
+    check( IsInGameThread() );
+
+    // Only the game thread modifies the volumes, so they can be read here without the lock.
+    // The obstacles are rasterized on copies of the volumes, and the lock is only held to swap them, never while rasterizing
+    TArray< TPair< int32, FSVOVolumeNavigationData > > updated_volumes;
+
+    for ( auto volume_index = 0; volume_index < VolumeNavigationData.Num(); ++volume_index )
+    {
+        auto volume_navigation_data = VolumeNavigationData[ volume_index ];
+
+        if ( update_volume( volume_navigation_data ) )
+        {
+            updated_volumes.Emplace( volume_index, MoveTemp( volume_navigation_data ) );
+        }
+    }
+
+    if ( updated_volumes.Num() == 0 )
+    {
+        return;
+    }
+
+    {
+        // The previous obstacles are released with updated_volumes, after the lock
+        FWriteScopeLock write_lock( VolumeNavigationDataLock );
+
+        for ( auto & pair : updated_volumes )
+        {
+            Swap( VolumeNavigationData[ pair.Key ], pair.Value );
+        }
+    }
+
+    RequestMemoryStatsUpdate();
+}
+
+void ASVONavigationData::UpdateVolumeSerials()
+{
+    if ( VolumeSerials.Num() < VolumeNavigationData.Num() )
+    {
+        VolumeSerials.SetNumZeroed( VolumeNavigationData.Num() );
+    }
+
+    // The serials of the indices past the end are kept, so a volume added later at one of them doesn't match the references to the removed volume
+    for ( auto volume_index = 0; volume_index < VolumeNavigationData.Num(); ++volume_index )
+    {
+        auto & volume_navigation_data = VolumeNavigationData[ volume_index ];
+        auto & volume_serial = VolumeSerials[ volume_index ];
+
+        if ( volume_serial.Key != volume_navigation_data.GetOctreeId() )
+        {
+            volume_serial.Key = volume_navigation_data.GetOctreeId();
+            ++volume_serial.Value;
+        }
+
+        volume_navigation_data.SetSerial( volume_serial.Value );
+    }
+}
+
+void ASVONavigationData::RegisterDynamicObstacles( FSVOVolumeNavigationData & data ) const
+{
+    for ( const auto & pair : DynamicObstacles )
+    {
+        if ( data.GetNavigationBounds().Intersect( pair.Value.Bounds ) )
+        {
+            data.AddDynamicObstacle( pair.Key, pair.Value );
+        }
+    }
+}
+
+void ASVONavigationData::InvalidatePathsCrossingObstacle( const FSVODynamicObstacle & obstacle )
+{
+    FScopeLock path_lock( &ActivePathsLock );
+
+    for ( auto path_index = ActivePaths.Num() - 1; path_index >= 0; --path_index )
+    {
+        const auto shared_path = ActivePaths[ path_index ].Pin();
+        if ( !shared_path.IsValid() )
+        {
+            ActivePaths.RemoveAtSwap( path_index, 1, /*bAllowShrinking=*/false );
+            continue;
+        }
+
+        if ( !shared_path->IsReady() || shared_path->GetIgnoreInvalidation() )
+        {
+            continue;
+        }
+
+        const auto & path_points = shared_path->GetPathPoints();
+
+        for ( auto point_index = 1; point_index < path_points.Num(); ++point_index )
+        {
+            if ( obstacle.IntersectsSegment( path_points[ point_index - 1 ].Location, path_points[ point_index ].Location ) )
+            {
+                shared_path->Invalidate();
+                ActivePaths.RemoveAtSwap( path_index, 1, /*bAllowShrinking=*/false );
+                break;
+            }
+        }
+    }
+}
+
 void ASVONavigationData::ClearNavigationData()
 {
-    VolumeNavigationData.Reset();
+    {
+        FWriteScopeLock write_lock( VolumeNavigationDataLock );
+        VolumeNavigationData.Reset();
+        UpdateVolumeSerials();
+    }
+
     RequestDrawingUpdate();
+    RequestMemoryStatsUpdate();
 }
 
 void ASVONavigationData::BuildNavigationData()
@@ -842,6 +1221,7 @@ void ASVONavigationData::OnNavigationDataGenerationFinished()
                             }
 
                             navigation_data_chunk->MarkPackageDirty();
+                            RequestMemoryStatsUpdate();
                             continue;
                         }
                     }
@@ -890,6 +1270,44 @@ void ASVONavigationData::OnNavigationDataGenerationFinished()
     }
 }
 
+void ASVONavigationData::RequestMemoryStatsUpdate()
+{
+    bMemoryStatsNeedUpdate = true;
+}
+
+void ASVONavigationData::UpdateMemoryStats()
+{
+#if STATS
+    // Stays requested while the stats are not collected, so they are right once the collection starts
+    if ( !bMemoryStatsNeedUpdate || !FThreadStats::IsCollectingData() )
+    {
+        return;
+    }
+
+    bMemoryStatsNeedUpdate = false;
+
+    const auto report = FSVONavigationDataMemoryReport::Make( *this );
+    const auto volumes_memory_size = report.GetAllocatedSize() - report.ChunksSize;
+
+    DEC_MEMORY_STAT_BY( STAT_SVONavigation_VolumesMemory, ReportedVolumesMemorySize );
+    DEC_MEMORY_STAT_BY( STAT_SVONavigation_ChunksMemory, ReportedChunksMemorySize );
+    INC_MEMORY_STAT_BY( STAT_SVONavigation_VolumesMemory, volumes_memory_size );
+    INC_MEMORY_STAT_BY( STAT_SVONavigation_ChunksMemory, report.ChunksSize );
+
+    ReportedVolumesMemorySize = volumes_memory_size;
+    ReportedChunksMemorySize = report.ChunksSize;
+#endif
+}
+
+void ASVONavigationData::ResetMemoryStats()
+{
+    DEC_MEMORY_STAT_BY( STAT_SVONavigation_VolumesMemory, ReportedVolumesMemorySize );
+    DEC_MEMORY_STAT_BY( STAT_SVONavigation_ChunksMemory, ReportedChunksMemorySize );
+
+    ReportedVolumesMemorySize = 0;
+    ReportedChunksMemorySize = 0;
+}
+
 USVONavigationDataChunk * ASVONavigationData::GetNavigationDataChunk( ULevel * level ) const
 {
     const auto this_name = GetFName();
@@ -947,7 +1365,11 @@ FPathFindingResult ASVONavigationData::FindPath( const FNavAgentProperties & /*a
             }
             else
             {
-                result.Result = FSVOPathFinder::GetPath( *svo_navigation_path, *self, path_finding_query.StartLocation, adjusted_end_location, path_finding_query.QueryFilter );
+                const auto volume_navigation_data = self->CopyVolumeNavigationDataContainingPoints( { path_finding_query.StartLocation, adjusted_end_location } );
+
+                result.Result = volume_navigation_data.IsSet()
+                                    ? FSVOPathFinder::GetPath( *svo_navigation_path, *self, volume_navigation_data.GetValue(), path_finding_query.StartLocation, adjusted_end_location, path_finding_query.QueryFilter )
+                                    : ENavigationQueryResult::Fail;
             }
         }
     }
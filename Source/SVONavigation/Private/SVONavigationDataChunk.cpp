@@ -4,6 +4,8 @@
 
 void USVONavigationDataChunk::Serialize( FArchive & archive )
 {
+    LLM_SCOPE_BYTAG( SVONavigation );
+
     Super::Serialize( archive );
 
     ESVOVersion version = ESVOVersion::Latest;
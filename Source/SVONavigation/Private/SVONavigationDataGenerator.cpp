@@ -1,26 +1,155 @@
 #include "SVONavigationDataGenerator.h"
 
+#include "SVOGenerationCache.h"
+#include "SVOGeometrySnapshot.h"
 #include "SVONavigationData.h"
 
-#include <GameFramework/PlayerController.h>
+#include <GameFramework/Controller.h>
+#include <GameFramework/Pawn.h>
+#include <Misc/App.h>
 #include <NavigationSystem.h>
 
-FSVOVolumeNavigationDataGenerator::FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds ) :
+namespace
+{
+    // In seconds
+    constexpr float PendingBoundsSortInterval = 0.5f;
+    // A running task is cancelled in favor of a pending volume at least 4 times closer to the players and the AI
+    constexpr float PreemptionSquaredDistanceRatio = 1.0f / 16.0f;
+    constexpr float PreemptionMaxProgress = 0.5f;
+
+    // Merges the dirty areas which intersect, so the nodes of a volume updated several times before its generation starts are only rasterized once
+    void AddDirtyArea( TArray< FBox > & dirty_areas, FBox dirty_area )
+    {
+        for ( auto index = dirty_areas.Num() - 1; index >= 0; --index )
+        {
+            if ( dirty_areas[ index ].Intersect( dirty_area ) )
+            {
+                dirty_area += dirty_areas[ index ];
+                dirty_areas.RemoveAtSwap( index, 1, false );
+
+                // The merged area is bigger, so it can now intersect areas we already checked
+                index = dirty_areas.Num();
+            }
+        }
+
+        dirty_areas.Add( dirty_area );
+    }
+}
+
+FSVOVolumeNavigationDataGenerator::FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds, const TArray< FBox > & dirty_areas ) :
     ParentGenerator( navigation_data_generator ),
     BoundsNavigationData(),
-    VolumeBounds( volume_bounds )
+    VolumeBounds( volume_bounds ),
+    DirtyAreas( dirty_areas ),
+    GenerationState( MakeShared< FSVOGenerationState, ESPMode::ThreadSafe >() )
 {
     NavDataConfig = navigation_data_generator.GetOwner()->GetConfig();
+
+    if ( DirtyAreas.Num() > 0 )
+    {
+        // Work on a copy of the current data, which stays in use until the updated data replaces it. The copy shares the octree of the current data, and the update builds a new one
+        if ( const auto * existing_navigation_data = navigation_data_generator.GetOwner()->GetVolumeNavigationData().FindByPredicate( [ &volume_bounds ]( const FSVOVolumeNavigationData & data ) {
+                 return data.GetVolumeBounds() == volume_bounds && data.GetData().IsValid();
+             } ) )
+        {
+            BoundsNavigationData = *existing_navigation_data;
+        }
+        else
+        {
+            DirtyAreas.Reset();
+        }
+    }
+
+    // The generator is created on the game thread, so this is the place to copy the geometry the task will rasterize
+    const auto & generation_settings = navigation_data_generator.GetGenerationSettings();
+    const auto * world = navigation_data_generator.GetWorld();
+
+#if WITH_EDITOR
+    if ( generation_settings.bUseGenerationCache && DirtyAreas.Num() == 0 && world != nullptr && !world->IsGameWorld() )
+    {
+        GenerationCacheKey = FSVOGenerationCache::ComputeKey( *world, volume_bounds, generation_settings, NavDataConfig.AgentRadius * 2.0f );
+
+        // No need to copy the geometry if the task is going to load the data
+        if ( FSVOGenerationCache::Contains( GenerationCacheKey ) )
+        {
+            return;
+        }
+    }
+#endif
+
+    if ( generation_settings.bUseGeometrySnapshot && world != nullptr )
+    {
+        // The navigation bounds are a cube centered on the volume, which can be up to twice as big as the volume. The rasterization boxes are also expanded by the clearance
+        auto snapshot_bounds = FBox::BuildAABB( volume_bounds.GetCenter(), FVector( volume_bounds.GetSize().GetAbsMax() ) ).ExpandBy( generation_settings.Clearance );
+
+        // An update only rasterizes the layer 1 nodes which intersect the dirty areas
+        if ( DirtyAreas.Num() > 0 )
+        {
+            const auto layer_one_node_size = BoundsNavigationData.GetData().GetLayer( 1 ).GetNodeSize();
+            FBox dirty_bounds( ForceInit );
+
+            for ( const auto & dirty_area : DirtyAreas )
+            {
+                dirty_bounds += dirty_area.ExpandBy( layer_one_node_size + 2.0f * generation_settings.Clearance );
+            }
+
+            snapshot_bounds = snapshot_bounds.Overlap( dirty_bounds );
+        }
+
+        // When some geometry can't be copied, the volume is rasterized with overlap queries against the physics scene, as without a snapshot
+        const auto geometry_snapshot = MakeShared< FSVOGeometrySnapshot, ESPMode::ThreadSafe >();
+        if ( geometry_snapshot->Gather( *world, snapshot_bounds, generation_settings ) )
+        {
+            GeometrySnapshot = geometry_snapshot;
+        }
+    }
 }
 
 bool FSVOVolumeNavigationDataGenerator::DoWork()
 {
+    // A task cancelled before it started is run on the thread which waits for it
+    if ( GenerationState->IsCancelled() )
+    {
+        return false;
+    }
+
     FSVOVolumeNavigationDataGenerationSettings generation_settings;
     generation_settings.GenerationSettings = ParentGenerator.GetGenerationSettings();
     generation_settings.World = ParentGenerator.GetWorld();
     generation_settings.VoxelExtent = NavDataConfig.AgentRadius * 2.0f;
+    generation_settings.GeometrySnapshot = GeometrySnapshot;
+    generation_settings.GenerationState = GenerationState;
+
+    if ( !GenerationCacheKey.IsEmpty() && FSVOGenerationCache::Load( BoundsNavigationData, GenerationCacheKey ) )
+    {
+        GenerationState->BeginPhase( ESVOGenerationPhase::Done, 0 );
+        GenerationReport = FSVOGenerationReport::Make( VolumeBounds, BoundsNavigationData.GetData(), *GenerationState, false, true );
+        return true;
+    }
 
-    BoundsNavigationData.GenerateNavigationData( VolumeBounds, generation_settings );
+    if ( DirtyAreas.Num() > 0 )
+    {
+        BoundsNavigationData.UpdateNavigationData( DirtyAreas, generation_settings );
+    }
+    else
+    {
+        BoundsNavigationData.GenerateNavigationData( VolumeBounds, generation_settings );
+    }
+
+    // The geometry snapshot is not needed anymore, even if the generation was cancelled
+    GeometrySnapshot.Reset();
+
+    if ( GenerationState->IsCancelled() )
+    {
+        return false;
+    }
+
+    GenerationReport = FSVOGenerationReport::Make( VolumeBounds, BoundsNavigationData.GetData(), *GenerationState, DirtyAreas.Num() > 0, false );
+
+    if ( !GenerationCacheKey.IsEmpty() && BoundsNavigationData.GetData().IsValid() )
+    {
+        FSVOGenerationCache::Save( BoundsNavigationData, GenerationCacheKey );
+    }
 
     return true;
 }
@@ -28,6 +157,9 @@ bool FSVOVolumeNavigationDataGenerator::DoWork()
 FSVONavigationDataGenerator::FSVONavigationDataGenerator( ASVONavigationData & navigation_data ) :
     NavigationData( navigation_data ),
     MaximumGeneratorTaskCount( 2 ),
+    CurrentMaximumGeneratorTaskCount( 2 ),
+    TimeUntilPendingBoundsSort( 0.0f ),
+    FinishedTaskCount( 0 ),
     IsInitialized( false )
 {
 }
@@ -41,6 +173,7 @@ void FSVONavigationDataGenerator::Init()
     ///** setup maximum number of active tile generator*/
     const int32 worker_threads_count = FTaskGraphInterface::Get().GetNumWorkerThreads();
     MaximumGeneratorTaskCount = FMath::Min( FMath::Max( worker_threads_count * 2, 1 ), NavigationData.MaxSimultaneousBoxGenerationJobsCount );
+    CurrentMaximumGeneratorTaskCount = MaximumGeneratorTaskCount;
     UE_LOG( LogNavigation, Log, TEXT( "Using max of %d workers to build SVO navigation." ), MaximumGeneratorTaskCount );
 
     // IsInitialized = true;
@@ -111,6 +244,13 @@ void FSVONavigationDataGenerator::EnsureBuildCompletion()
 void FSVONavigationDataGenerator::CancelBuild()
 {
     PendingBoundsDataGenerationElements.Empty();
+    FinishedTaskCount = 0;
+
+    // Ask all the tasks to stop before waiting for any of them
+    for ( auto & element : RunningBoundsDataGenerationElements )
+    {
+        element.Cancel();
+    }
 
     for ( auto & element : RunningBoundsDataGenerationElements )
     {
@@ -133,11 +273,33 @@ void FSVONavigationDataGenerator::TickAsyncBuild( float delta_seconds )
         return;
     }
 
+    const auto * world = GetWorld();
+
+    // The players and the AI move, so the priorities of the pending volumes are computed again from time to time
+    TimeUntilPendingBoundsSort -= delta_seconds;
+
+    if ( TimeUntilPendingBoundsSort <= 0.0f && PendingBoundsDataGenerationElements.Num() > 0 )
+    {
+        SortPendingBounds();
+    }
+
+    UpdateMaximumGeneratorTaskCount();
+
+    if ( world != nullptr && world->IsGameWorld() )
+    {
+        PreemptFarthestRunningTask();
+    }
+
     const int32 running_tasks_count = navigation_system->GetNumRunningBuildTasks();
 
-    const int32 tasks_to_submit_count = MaximumGeneratorTaskCount - running_tasks_count;
+    const int32 tasks_to_submit_count = CurrentMaximumGeneratorTaskCount - running_tasks_count;
 
-    const auto finished_boxes = ProcessAsyncTasks( tasks_to_submit_count );
+    // In game worlds, the time spent on the game thread to start and finish the tasks can be limited, to not cause hitches while the geometry changes
+    const auto time_budget = world != nullptr && world->IsGameWorld()
+                                 ? NavigationData.RuntimeGenerationTimeBudget
+                                 : 0.0f;
+
+    const auto finished_boxes = ProcessAsyncTasks( tasks_to_submit_count, time_budget );
 
     if ( finished_boxes.Num() > 0 )
     {
@@ -163,16 +325,55 @@ void FSVONavigationDataGenerator::RebuildDirtyAreas( const TArray< FNavigationDi
 
         for ( const auto & matching_bounds_element : matching_bounds )
         {
+            // A dirty area which covers the whole volume, or a volume without navigation data, requires a full generation.
+            // Otherwise only the part of the volume which intersects the dirty area is rasterized again
+            const auto must_generate_whole_volume = ( dirty_area.Bounds.IsInsideOrOn( matching_bounds_element.Min ) && dirty_area.Bounds.IsInsideOrOn( matching_bounds_element.Max ) )
+                                                    || !NavigationData.GetVolumeNavigationData().ContainsByPredicate( [ &matching_bounds_element ]( const FSVOVolumeNavigationData & data ) {
+                                                           return data.GetVolumeBounds() == matching_bounds_element && data.GetData().IsValid();
+                                                       } );
+
+            auto * pending_element = PendingBoundsDataGenerationElements.FindByPredicate( [ &matching_bounds_element ]( const FPendingBoundsDataGenerationElement & pending_element ) {
+                return pending_element.VolumeBounds == matching_bounds_element;
+            } );
+
             // Don't add another pending generation if one is already there for the navigation bounds the dirty area is in
-            if ( PendingBoundsDataGenerationElements.FindByPredicate( [ &matching_bounds_element ]( const FPendingBoundsDataGenerationElement & pending_element ) {
-                     return pending_element.VolumeBounds == matching_bounds_element;
-                 } ) == nullptr )
+            // The running generation of the volume is obsolete if the whole volume must be generated again
+            if ( must_generate_whole_volume )
             {
-                FPendingBoundsDataGenerationElement pending_box_element;
-                pending_box_element.VolumeBounds = matching_bounds_element;
-                PendingBoundsDataGenerationElements.Emplace( pending_box_element );
+                if ( auto * running_element = RunningBoundsDataGenerationElements.FindByPredicate( [ &matching_bounds_element ]( const FRunningBoundsDataGenerationElement & element ) {
+                         return element.VolumeBounds == matching_bounds_element && !element.ShouldDiscard;
+                     } ) )
+                {
+                    running_element->Cancel();
+                }
+            }
 
-                NavigationData.RemoveDataInBounds( matching_bounds_element );
+            if ( pending_element == nullptr )
+            {
+                pending_element = &PendingBoundsDataGenerationElements.AddDefaulted_GetRef();
+                pending_element->VolumeBounds = matching_bounds_element;
+
+                if ( must_generate_whole_volume )
+                {
+                    NavigationData.RemoveDataInBounds( matching_bounds_element );
+                }
+                else
+                {
+                    AddDirtyArea( pending_element->DirtyAreas, dirty_area.Bounds );
+                }
+            }
+            // Already a pending update. Merge the dirty areas, unless the whole volume must now be generated
+            else if ( pending_element->DirtyAreas.Num() > 0 )
+            {
+                if ( must_generate_whole_volume )
+                {
+                    pending_element->DirtyAreas.Reset();
+                    NavigationData.RemoveDataInBounds( matching_bounds_element );
+                }
+                else
+                {
+                    AddDirtyArea( pending_element->DirtyAreas, dirty_area.Bounds );
+                }
             }
         }
     }
@@ -196,20 +397,73 @@ int32 FSVONavigationDataGenerator::GetNumRemaningBuildTasks() const
 
 int32 FSVONavigationDataGenerator::GetNumRunningBuildTasks() const
 {
-    return RunningBoundsDataGenerationElements.Num();
+    // The cancelled tasks stop as soon as they can. They don't count, so the task which preempted one of them starts right away,
+    // instead of another task being preempted on the next tick for the same pending volume
+    int32 running_task_count = 0;
+
+    for ( const auto & element : RunningBoundsDataGenerationElements )
+    {
+        if ( !element.ShouldDiscard )
+        {
+            running_task_count++;
+        }
+    }
+
+    return running_task_count;
 }
 
-void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector2D > & seed_locations, UWorld & world ) const
+void FSVONavigationDataGenerator::GetRunningTasksProgress( TArray< FSVOVolumeGenerationProgress > & tasks_progress ) const
 {
-    // Collect players positions
-    for ( FConstPlayerControllerIterator player_iterator = world.GetPlayerControllerIterator(); player_iterator; ++player_iterator )
+    for ( const auto & element : RunningBoundsDataGenerationElements )
     {
-        if ( const auto * player_controller = player_iterator->Get() )
+        if ( element.AsyncTask == nullptr || element.ShouldDiscard )
         {
-            if ( const auto * pawn = player_controller->GetPawn() )
+            continue;
+        }
+
+        const auto & generation_state = element.AsyncTask->GetTask().BoxNavigationDataGenerator->GetGenerationState();
+
+        auto & task_progress = tasks_progress.AddDefaulted_GetRef();
+        task_progress.VolumeBounds = element.VolumeBounds;
+        task_progress.Phase = generation_state.GetPhase();
+        task_progress.NodeCount = generation_state.GetNodeCount();
+        task_progress.ProcessedNodeCount = generation_state.GetProcessedNodeCount();
+        task_progress.Progress = generation_state.GetProgress();
+    }
+}
+
+float FSVONavigationDataGenerator::GetBuildProgress() const
+{
+    const auto task_count = FinishedTaskCount + GetNumRemaningBuildTasks();
+
+    if ( task_count == 0 )
+    {
+        return 1.0f;
+    }
+
+    auto progress = static_cast< float >( FinishedTaskCount );
+
+    for ( const auto & element : RunningBoundsDataGenerationElements )
+    {
+        if ( element.AsyncTask != nullptr && !element.ShouldDiscard )
+        {
+            progress += element.AsyncTask->GetTask().BoxNavigationDataGenerator->GetGenerationState().GetProgress();
+        }
+    }
+
+    return progress / task_count;
+}
+
+void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector > & seed_locations, UWorld & world ) const
+{
+    // Collect the positions of the pawns of the players and of the AI, which are the ones which query the navigation data
+    for ( FConstControllerIterator controller_iterator = world.GetControllerIterator(); controller_iterator; ++controller_iterator )
+    {
+        if ( const auto * controller = controller_iterator->Get() )
+        {
+            if ( const auto * pawn = controller->GetPawn() )
             {
-                const FVector2D seed_location( pawn->GetActorLocation() );
-                seed_locations.Add( seed_location );
+                seed_locations.Add( pawn->GetActorLocation() );
             }
         }
     }
@@ -217,30 +471,130 @@ void FSVONavigationDataGenerator::GetSeedLocations( TArray< FVector2D > & seed_l
 
 void FSVONavigationDataGenerator::SortPendingBounds()
 {
+    TimeUntilPendingBoundsSort = PendingBoundsSortInterval;
+
     if ( UWorld * current_world = GetWorld() )
     {
-        TArray< FVector2D > seed_locations;
+        TArray< FVector > seed_locations;
         GetSeedLocations( seed_locations, *current_world );
 
         if ( seed_locations.Num() == 0 )
         {
-            seed_locations.Add( FVector2D( TotalNavigationBounds.GetCenter() ) );
+            seed_locations.Add( TotalNavigationBounds.GetCenter() );
         }
 
-        if ( seed_locations.Num() > 0 )
-        {
-            for ( auto & element : PendingBoundsDataGenerationElements )
+        const auto get_seed_distance = [ &seed_locations ]( const FBox & volume_bounds ) {
+            auto seed_distance = MAX_flt;
+
+            // The distance to the closest point of the volume, which is 0 when the seed is inside
+            for ( const auto & seed_location : seed_locations )
             {
-                FVector2D tile_center_2d = FVector2D( element.VolumeBounds.GetCenter() );
-                for ( const auto & seed_location : seed_locations )
-                {
-                    element.SeedDistance = FMath::Min( element.SeedDistance, FVector2D::DistSquared( tile_center_2d, seed_location ) );
-                }
+                seed_distance = FMath::Min( seed_distance, static_cast< float >( volume_bounds.ComputeSquaredDistanceToPoint( seed_location ) ) );
             }
 
-            PendingBoundsDataGenerationElements.Sort();
+            return seed_distance;
+        };
+
+        for ( auto & element : PendingBoundsDataGenerationElements )
+        {
+            element.SeedDistance = get_seed_distance( element.VolumeBounds );
+        }
+
+        for ( auto & element : RunningBoundsDataGenerationElements )
+        {
+            element.SeedDistance = get_seed_distance( element.VolumeBounds );
+        }
+
+        PendingBoundsDataGenerationElements.Sort();
+    }
+}
+
+void FSVONavigationDataGenerator::UpdateMaximumGeneratorTaskCount()
+{
+    const auto * world = GetWorld();
+    const auto target_frame_time = NavigationData.RuntimeGenerationTargetFrameTime;
+
+    if ( world == nullptr || !world->IsGameWorld() || target_frame_time <= 0.0f )
+    {
+        CurrentMaximumGeneratorTaskCount = MaximumGeneratorTaskCount;
+        return;
+    }
+
+    // The tasks compete with the game for the worker threads: back off quickly when the frames are too long, and come back slowly
+    const auto frame_time = FApp::GetDeltaTime() * 1000.0;
+
+    if ( frame_time > target_frame_time )
+    {
+        CurrentMaximumGeneratorTaskCount = FMath::Max( 1, CurrentMaximumGeneratorTaskCount / 2 );
+    }
+    else if ( frame_time < target_frame_time * 0.9 )
+    {
+        CurrentMaximumGeneratorTaskCount = FMath::Min( CurrentMaximumGeneratorTaskCount + 1, MaximumGeneratorTaskCount );
+    }
+}
+
+void FSVONavigationDataGenerator::PreemptFarthestRunningTask()
+{
+    if ( PendingBoundsDataGenerationElements.Num() == 0 || GetNumRunningBuildTasks() < CurrentMaximumGeneratorTaskCount )
+    {
+        return;
+    }
+
+    // The pending elements are sorted by decreasing distance
+    const auto & nearest_pending_element = PendingBoundsDataGenerationElements.Last();
+
+    FRunningBoundsDataGenerationElement * farthest_running_element = nullptr;
+
+    for ( auto & element : RunningBoundsDataGenerationElements )
+    {
+        // Don't throw away the work of the tasks which are almost done
+        if ( element.ShouldDiscard || element.AsyncTask == nullptr || element.AsyncTask->GetTask().BoxNavigationDataGenerator->GetGenerationState().GetProgress() > PreemptionMaxProgress )
+        {
+            continue;
         }
+
+        if ( farthest_running_element == nullptr || element.SeedDistance > farthest_running_element->SeedDistance )
+        {
+            farthest_running_element = &element;
+        }
+    }
+
+    if ( farthest_running_element == nullptr || nearest_pending_element.SeedDistance >= farthest_running_element->SeedDistance * PreemptionSquaredDistanceRatio )
+    {
+        return;
     }
+
+    // Queue the work of the preempted task again, merged with a pending generation of the same volume if there is one
+    const auto & preempted_dirty_areas = farthest_running_element->AsyncTask->GetTask().BoxNavigationDataGenerator->GetDirtyAreas();
+    const auto & volume_bounds = farthest_running_element->VolumeBounds;
+
+    if ( auto * pending_element = PendingBoundsDataGenerationElements.FindByPredicate( [ &volume_bounds ]( const FPendingBoundsDataGenerationElement & element ) {
+             return element.VolumeBounds == volume_bounds;
+         } ) )
+    {
+        if ( preempted_dirty_areas.Num() == 0 )
+        {
+            pending_element->DirtyAreas.Reset();
+        }
+        else if ( pending_element->DirtyAreas.Num() > 0 )
+        {
+            for ( const auto & dirty_area : preempted_dirty_areas )
+            {
+                AddDirtyArea( pending_element->DirtyAreas, dirty_area );
+            }
+        }
+    }
+    else
+    {
+        auto & new_pending_element = PendingBoundsDataGenerationElements.AddDefaulted_GetRef();
+        new_pending_element.VolumeBounds = volume_bounds;
+        new_pending_element.DirtyAreas = preempted_dirty_areas;
+        new_pending_element.SeedDistance = farthest_running_element->SeedDistance;
+
+        PendingBoundsDataGenerationElements.Sort();
+    }
+
+    farthest_running_element->Cancel();
 }
 
 void FSVONavigationDataGenerator::UpdateNavigationBounds()
@@ -285,23 +639,33 @@ void FSVONavigationDataGenerator::UpdateNavigationBounds()
     }
 }
 
-TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_to_process_count )
+TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_to_process_count, const float time_budget )
 {
     const bool has_tasks_at_start = GetNumRemaningBuildTasks() > 0;
+    const auto end_time = time_budget > 0.0f
+                              ? FPlatformTime::Seconds() + time_budget / 1000.0
+                              : TNumericLimits< double >::Max();
 
     int32 processed_tasks_count = 0;
     // Submit pending tile elements
     for ( int32 element_index = PendingBoundsDataGenerationElements.Num() - 1; element_index >= 0 && processed_tasks_count < task_to_process_count; element_index-- )
     {
+        // Always start at least one task, so the generation progresses even with a tiny budget
+        if ( processed_tasks_count > 0 && FPlatformTime::Seconds() > end_time )
+        {
+            break;
+        }
+
         FPendingBoundsDataGenerationElement & PendingElement = PendingBoundsDataGenerationElements[ element_index ];
         FRunningBoundsDataGenerationElement running_element( PendingElement.VolumeBounds );
+        running_element.SeedDistance = PendingElement.SeedDistance;
 
         if ( RunningBoundsDataGenerationElements.Contains( running_element ) )
         {
             continue;
         }
 
-        TUniquePtr< FSVOBoxGeneratorTask > task = MakeUnique< FSVOBoxGeneratorTask >( CreateBoxNavigationGenerator( PendingElement.VolumeBounds ) );
+        TUniquePtr< FSVOBoxGeneratorTask > task = MakeUnique< FSVOBoxGeneratorTask >( CreateBoxNavigationGenerator( PendingElement.VolumeBounds, PendingElement.DirtyAreas ) );
 
         running_element.AsyncTask = task.Release();
 
@@ -324,6 +688,11 @@ TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_
     {
         // QUICK_SCOPE_CYCLE_COUNTER( STAT_RecastNavMeshGenerator_ProcessTileTasks_FinishedTasks );
 
+        if ( finished_boxes.Num() > 0 && FPlatformTime::Seconds() > end_time )
+        {
+            break;
+        }
+
         FRunningBoundsDataGenerationElement & element = RunningBoundsDataGenerationElements[ index ];
         check( element.AsyncTask != nullptr );
 
@@ -334,23 +703,41 @@ TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_
 
         if ( element.ShouldDiscard )
         {
+            delete element.AsyncTask;
+            element.AsyncTask = nullptr;
+            RunningBoundsDataGenerationElements.RemoveAtSwap( index, 1, false );
             continue;
         }
 
         auto & box_generator = *element.AsyncTask->GetTask().BoxNavigationDataGenerator;
 
-        NavigationData.AddVolumeNavigationData( box_generator.GetBoundsNavigationData() );
+        NavigationData.AddVolumeNavigationData( MoveTemp( box_generator.GetBoundsNavigationData() ) );
+        NavigationData.AddGenerationReport( box_generator.GetGenerationReport() );
 
-        finished_boxes.Emplace( MoveTemp( element.VolumeBounds ) );
+        // Only the paths going through the updated parts of the volume need to be invalidated
+        if ( box_generator.GetDirtyAreas().Num() > 0 )
+        {
+            for ( const auto & dirty_area : box_generator.GetDirtyAreas() )
+            {
+                finished_boxes.Emplace( dirty_area.ExpandBy( GenerationSettings.Clearance ) );
+            }
+        }
+        else
+        {
+            finished_boxes.Emplace( MoveTemp( element.VolumeBounds ) );
+        }
 
         delete element.AsyncTask;
         element.AsyncTask = nullptr;
         RunningBoundsDataGenerationElements.RemoveAtSwap( index, 1, false );
+        FinishedTaskCount++;
     }
 
     const bool has_tasks_at_end = GetNumRemaningBuildTasks() > 0;
     if ( has_tasks_at_start && !has_tasks_at_end )
     {
+        FinishedTaskCount = 0;
+
         // QUICK_SCOPE_CYCLE_COUNTER( STAT_RecastNavMeshGenerator_OnNavMeshGenerationFinished );
         NavigationData.OnNavigationDataGenerationFinished();
     }
@@ -358,10 +745,10 @@ TArray< FBox > FSVONavigationDataGenerator::ProcessAsyncTasks( const int32 task_
     return finished_boxes;
 }
 
-TSharedRef< FSVOVolumeNavigationDataGenerator > FSVONavigationDataGenerator::CreateBoxNavigationGenerator( const FBox & box )
+TSharedRef< FSVOVolumeNavigationDataGenerator > FSVONavigationDataGenerator::CreateBoxNavigationGenerator( const FBox & box, const TArray< FBox > & dirty_areas )
 {
     // SCOPE_CYCLE_COUNTER(STAT_SVONavigation_CreateBoxNavigationGenerator);
 
-    TSharedRef< FSVOVolumeNavigationDataGenerator > box_navigation_data_generator = MakeShareable( new FSVOVolumeNavigationDataGenerator( *this, box ) );
+    TSharedRef< FSVOVolumeNavigationDataGenerator > box_navigation_data_generator = MakeShareable( new FSVOVolumeNavigationDataGenerator( *this, box, dirty_areas ) );
     return box_navigation_data_generator;
 }
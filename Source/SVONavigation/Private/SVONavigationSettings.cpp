@@ -5,5 +5,6 @@
 USVONavigationSettings::USVONavigationSettings()
 {
     bNavigationAutoUpdateEnabled = true;
+    bCompressNavigationData = false;
     DefaultRaycasterClass = USVORayCaster_OctreeTraversal::StaticClass();
 }
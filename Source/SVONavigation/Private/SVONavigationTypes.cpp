@@ -1,9 +1,156 @@
 #include "SVONavigationTypes.h"
 
 #include "PathFinding/SVOPathFindingAlgorithm.h"
+#include "SVOHelpers.h"
+#include "SVOMemoryReport.h"
+
+#include <Async/ParallelFor.h>
+
+namespace
+{
+    enum class ELeafRunType : uint8
+    {
+        Free,
+        Occluded,
+        Mixed
+    };
+
+    ELeafRunType GetLeafRunType( const FSVOLeafNode & leaf_node )
+    {
+        if ( leaf_node.IsCompletelyFree() )
+        {
+            return ELeafRunType::Free;
+        }
+
+        return leaf_node.IsCompletelyOccluded()
+                   ? ELeafRunType::Occluded
+                   : ELeafRunType::Mixed;
+    }
+
+    // Does not fit in 32 bits for the lower layers of the large volumes
+    uint64 GetLayerMaxNodeCount( const int voxel_exponent, const LayerIndex layer_index )
+    {
+        return 1ULL << 3 * ( voxel_exponent - layer_index );
+    }
+
+    // One read or write for the whole array, instead of one per element
+    template < typename _TYPE_, typename _ALLOCATOR_ >
+    void SerializeBulk( FArchive & archive, TArray< _TYPE_, _ALLOCATOR_ > & array )
+    {
+        auto num = array.Num();
+        archive << num;
+
+        if ( archive.IsLoading() )
+        {
+            const auto remaining_size = archive.TotalSize() - archive.Tell();
+
+            if ( num < 0 || ( archive.TotalSize() >= 0 && static_cast< int64 >( num * sizeof( _TYPE_ ) ) > remaining_size ) )
+            {
+                archive.SetError();
+                array.Reset();
+                return;
+            }
+
+            array.SetNumUninitialized( num );
+        }
+
+        archive.Serialize( array.GetData(), static_cast< int64 >( num ) * sizeof( _TYPE_ ) );
+    }
+
+    // 7 bits per byte, the high bit tells if more bytes follow. The deltas between the sorted morton codes mostly fit in one byte
+    void WriteVarInt( TArray< uint8 > & bytes, uint64 value )
+    {
+        while ( value >= 0x80 )
+        {
+            bytes.Add( static_cast< uint8 >( value | 0x80 ) );
+            value >>= 7;
+        }
+
+        bytes.Add( static_cast< uint8 >( value ) );
+    }
+
+    template < typename _TYPE_ >
+    void WriteValue( TArray< uint8 > & bytes, const _TYPE_ value )
+    {
+        bytes.Append( reinterpret_cast< const uint8 * >( &value ), sizeof( _TYPE_ ) );
+    }
+
+    // Reads what the functions above wrote. Flags an error instead of reading past the end of the buffer
+    class FByteReader
+    {
+    public:
+        explicit FByteReader( const TArray< uint8 > & bytes ) :
+            Bytes( bytes ),
+            Offset( 0 ),
+            bIsError( false )
+        {
+        }
+
+        uint64 ReadVarInt()
+        {
+            uint64 value = 0;
+
+            for ( auto shift = 0; shift < 64; shift += 7 )
+            {
+                if ( Offset >= Bytes.Num() )
+                {
+                    break;
+                }
+
+                const auto byte = Bytes[ Offset++ ];
+                value |= static_cast< uint64 >( byte & 0x7F ) << shift;
+
+                if ( ( byte & 0x80 ) == 0 )
+                {
+                    return value;
+                }
+            }
+
+            bIsError = true;
+            return 0;
+        }
+
+        template < typename _TYPE_ >
+        _TYPE_ ReadValue()
+        {
+            _TYPE_ value {};
+
+            if ( Offset + static_cast< int32 >( sizeof( _TYPE_ ) ) > Bytes.Num() )
+            {
+                bIsError = true;
+                return value;
+            }
+
+            FMemory::Memcpy( &value, Bytes.GetData() + Offset, sizeof( _TYPE_ ) );
+            Offset += sizeof( _TYPE_ );
+            return value;
+        }
+
+        bool IsError() const
+        {
+            return bIsError;
+        }
+
+        bool IsAtEnd() const
+        {
+            return Offset == Bytes.Num();
+        }
+
+    private:
+        const TArray< uint8 > & Bytes;
+        int32 Offset;
+        bool bIsError;
+    };
+}
 
 const FSVONodeAddress FSVONodeAddress::InvalidAddress;
 
+FSVOLeafNodes::FSVOLeafNodes() :
+    LeafNodeSize( 0.0f ),
+    LeafNodeCount( 0 )
+{
+}
+
 void FSVOLeafNodes::Initialize( const float leaf_size )
 {
     LeafNodeSize = leaf_size;
@@ -11,7 +158,9 @@ void FSVOLeafNodes::Initialize( const float leaf_size )
 
 void FSVOLeafNodes::Reset()
 {
-    LeafNodes.Reset();
+    LeafNodeCount = 0;
+    Words.Reset();
+    PartiallyOccludedSubNodes.Reset();
 }
 
 FSVONode::FSVONode() :
@@ -28,52 +177,418 @@ FSVONode::FSVONode( const ::MortonCode morton_code ) :
 {
 }
 
-int FSVOLeafNodes::GetAllocatedSize() const
+int64 FSVOLeafNodes::GetAllocatedSize() const
 {
-    return LeafNodes.Num() * sizeof( FSVOLeafNode );
+    return Words.GetAllocatedSize() + PartiallyOccludedSubNodes.GetAllocatedSize();
 }
 
-void FSVOLeafNodes::AllocateLeafNodes( const int leaf_count )
+void FSVOLeafNodes::Build( const TArray< uint_fast64_t > & sub_nodes )
 {
-    LeafNodes.Reserve( leaf_count );
+    Reset();
+
+    LeafNodeCount = sub_nodes.Num();
+    // Zeroed so the padding of the words saved in the flat layout is always the same
+    Words.SetNumZeroed( ( LeafNodeCount + 63 ) / 64 );
+
+    for ( auto leaf_index = 0; leaf_index < LeafNodeCount; ++leaf_index )
+    {
+        auto & word = Words[ leaf_index >> 6 ];
+        const auto leaf_bit = 1ULL << ( leaf_index & 63 );
+        const auto leaf_sub_nodes = sub_nodes[ leaf_index ];
+
+        if ( leaf_index % 64 == 0 )
+        {
+            word.PartiallyOccludedRank = PartiallyOccludedSubNodes.Num();
+        }
+
+        if ( leaf_sub_nodes == static_cast< uint_fast64_t >( -1 ) )
+        {
+            word.CompletelyOccludedBits |= leaf_bit;
+        }
+        else if ( leaf_sub_nodes != 0 )
+        {
+            word.PartiallyOccludedBits |= leaf_bit;
+            PartiallyOccludedSubNodes.Add( leaf_sub_nodes );
+        }
+    }
+
+    PartiallyOccludedSubNodes.Shrink();
 }
 
-void FSVOLeafNodes::AddLeafNode( const LeafIndex leaf_index, const SubNodeIndex sub_node_index, const bool is_occluded )
+void FSVOLeafNodes::SerializeFlat( FArchive & archive )
 {
-    if ( leaf_index > LeafNodes.Num() - 1 )
+    archive << LeafNodeSize;
+    archive << LeafNodeCount;
+    SerializeBulk( archive, Words );
+    SerializeBulk( archive, PartiallyOccludedSubNodes );
+
+    if ( archive.IsLoading() )
     {
-        AddEmptyLeafNode();
+        const auto is_consistent = LeafNodeCount >= 0
+                                   && Words.Num() == ( LeafNodeCount + 63 ) / 64
+                                   && ( Words.Num() == 0 || Words.Last().PartiallyOccludedRank + FPlatformMath::CountBits( Words.Last().PartiallyOccludedBits ) == static_cast< uint32 >( PartiallyOccludedSubNodes.Num() ) );
+
+        if ( !is_consistent )
+        {
+            Reset();
+        }
     }
+}
 
-    if ( is_occluded )
+void FSVOLeafNodes::Compress( TArray< uint8 > & bytes ) const
+{
+    WriteValue( bytes, LeafNodeSize );
+    WriteVarInt( bytes, LeafNodeCount );
+
+    for ( auto run_start_index = 0; run_start_index < LeafNodeCount; )
     {
-        LeafNodes[ leaf_index ].MarkSubNodeAsOccluded( sub_node_index );
+        const auto run_type = GetLeafRunType( GetLeafNode( run_start_index ) );
+        auto run_end_index = run_start_index + 1;
+
+        while ( run_end_index < LeafNodeCount && GetLeafRunType( GetLeafNode( run_end_index ) ) == run_type )
+        {
+            run_end_index++;
+        }
+
+        WriteVarInt( bytes, static_cast< uint64 >( run_end_index - run_start_index ) << 2 | static_cast< uint8 >( run_type ) );
+
+        // Only the leaves which are partially occluded need their sub nodes
+        if ( run_type == ELeafRunType::Mixed )
+        {
+            for ( auto leaf_index = run_start_index; leaf_index < run_end_index; ++leaf_index )
+            {
+                WriteValue( bytes, GetLeafNode( leaf_index ).SubNodes );
+            }
+        }
+
+        run_start_index = run_end_index;
     }
 }
 
-void FSVOLeafNodes::AddEmptyLeafNode()
+bool FSVOLeafNodes::Decompress( const TArray< uint8 > & bytes, const uint64 max_leaf_count )
 {
-    LeafNodes.AddDefaulted();
+    FByteReader reader( bytes );
+
+    LeafNodeSize = reader.ReadValue< float >();
+    const auto stored_leaf_count = reader.ReadVarInt();
+
+    if ( reader.IsError() || stored_leaf_count > FMath::Min< uint64 >( max_leaf_count, MAX_int32 ) )
+    {
+        return false;
+    }
+
+    const auto leaf_count = static_cast< int32 >( stored_leaf_count );
+
+    TArray< uint_fast64_t > sub_nodes;
+    sub_nodes.SetNumUninitialized( leaf_count );
+
+    for ( auto leaf_index = 0; leaf_index < leaf_count; )
+    {
+        const auto run_header = reader.ReadVarInt();
+        const auto run_length = run_header >> 2;
+        const auto run_type = static_cast< ELeafRunType >( run_header & 3 );
+
+        if ( reader.IsError() || run_length == 0 || run_length > static_cast< uint64 >( leaf_count - leaf_index ) || run_type > ELeafRunType::Mixed )
+        {
+            return false;
+        }
+
+        for ( const auto run_end_index = leaf_index + static_cast< int32 >( run_length ); leaf_index < run_end_index; ++leaf_index )
+        {
+            switch ( run_type )
+            {
+                case ELeafRunType::Free:
+                {
+                    sub_nodes[ leaf_index ] = 0;
+                }
+                break;
+                case ELeafRunType::Occluded:
+                {
+                    sub_nodes[ leaf_index ] = -1;
+                }
+                break;
+                default:
+                {
+                    sub_nodes[ leaf_index ] = reader.ReadValue< uint_fast64_t >();
+                }
+                break;
+            }
+        }
+    }
+
+    if ( reader.IsError() || !reader.IsAtEnd() )
+    {
+        return false;
+    }
+
+    Build( sub_nodes );
+    return true;
 }
 
 FSVOLayer::FSVOLayer() :
-    MaxNodeCount( -1 ),
-    NodeSize( 0.0f )
+    MaxNodeCount( 0 ),
+    NodeSize( 0.0f ),
+    bStoresNeighborLinks( true )
 {
 }
 
-FSVOLayer::FSVOLayer( const int max_node_count, const float node_size ) :
+FSVOLayer::FSVOLayer( const uint64 max_node_count, const float node_size, const bool store_neighbor_links ) :
     MaxNodeCount( max_node_count ),
-    NodeSize( node_size )
+    NodeSize( node_size ),
+    bStoresNeighborLinks( store_neighbor_links )
+{
+}
+
+void FSVOMortonCodeIndex::Build( const TSVOLayerArray< MortonCode > & morton_codes )
+{
+    Reset();
+
+    if ( morton_codes.Num() == 0 )
+    {
+        return;
+    }
+
+    const auto parent_morton_code_count = ( morton_codes.Last() >> 3 ) + 1;
+    Words.SetNumZeroed( ( parent_morton_code_count + 63 ) / 64 );
+
+    // The siblings are stored next to each other, starting with the first child of their parent
+    for ( auto node_index = 0; node_index < morton_codes.Num(); node_index += 8 )
+    {
+        const auto parent_morton_code = morton_codes[ node_index ] >> 3;
+        Words[ parent_morton_code >> 6 ] |= 1ULL << ( parent_morton_code & 63 );
+    }
+
+    Ranks.SetNumUninitialized( Words.Num() );
+
+    uint32 rank = 0;
+    for ( auto word_index = 0; word_index < Words.Num(); ++word_index )
+    {
+        Ranks[ word_index ] = rank;
+        rank += FPlatformMath::CountBits( Words[ word_index ] );
+    }
+}
+
+void FSVOMortonCodeIndex::Reset()
+{
+    Words.Empty();
+    Ranks.Empty();
+}
+
+void FSVOMortonCodeIndex::SerializeFlat( FArchive & archive )
+{
+    SerializeBulk( archive, Words );
+    SerializeBulk( archive, Ranks );
+
+    if ( Words.Num() != Ranks.Num() )
+    {
+        Reset();
+    }
+}
+
+int64 FSVOMortonCodeIndex::GetAllocatedSize() const
+{
+    return Words.GetAllocatedSize() + Ranks.GetAllocatedSize();
+}
+
+FSVONode FSVOLayer::GetNode( const NodeIndex node_index ) const
+{
+    FSVONode node( MortonCodes[ node_index ] );
+    node.Parent = Parents[ node_index ];
+    node.FirstChild = FirstChildren[ node_index ];
+
+    if ( !HasNeighborLinks() )
+    {
+        return node;
+    }
+
+    for ( NeighborDirection direction = 0; direction < 6; ++direction )
+    {
+        node.Neighbors[ direction ] = GetNodeNeighbor( node_index, direction );
+    }
+
+    return node;
+}
+
+int64 FSVOLayer::GetAllocatedSize() const
+{
+    return GetMemoryReport().GetAllocatedSize();
+}
+
+FSVOLayerMemoryReport FSVOLayer::GetMemoryReport() const
+{
+    FSVOLayerMemoryReport report;
+    report.NodeCount = GetNodeCount();
+    report.MortonCodesSize = MortonCodes.GetAllocatedSize();
+    report.FirstChildrenSize = FirstChildren.GetAllocatedSize();
+    report.NeighborsSize = Neighbors.GetAllocatedSize();
+    report.ParentsSize = Parents.GetAllocatedSize();
+    report.MortonCodeIndexSize = MortonCodeIndex.GetAllocatedSize();
+    report.SlackSize = MortonCodes.GetSlack() * sizeof( MortonCode ) + ( FirstChildren.GetSlack() + Neighbors.GetSlack() + Parents.GetSlack() ) * sizeof( FSVONodeAddress );
+    return report;
+}
+
+void FSVOLayer::ReserveNodes( const int32 node_count )
+{
+    MortonCodes.Reserve( node_count );
+    FirstChildren.Reserve( node_count );
+    if ( HasNeighborLinks() )
+    {
+        Neighbors.Reserve( node_count * 6 );
+    }
+    Parents.Reserve( node_count );
+}
+
+NodeIndex FSVOLayer::AddNode( const MortonCode morton_code )
+{
+    const NodeIndex node_index = MortonCodes.Add( morton_code );
+    FirstChildren.AddDefaulted();
+    if ( HasNeighborLinks() )
+    {
+        Neighbors.AddDefaulted( 6 );
+    }
+    Parents.AddDefaulted();
+    return node_index;
+}
+
+void FSVOLayer::SerializeFlat( FArchive & archive, const uint64 max_node_count )
+{
+    archive << NodeSize;
+    SerializeBulk( archive, MortonCodes );
+    SerializeBulk( archive, FirstChildren );
+    SerializeBulk( archive, Neighbors );
+    SerializeBulk( archive, Parents );
+    MortonCodeIndex.SerializeFlat( archive );
+
+    if ( archive.IsLoading() )
+    {
+        MaxNodeCount = max_node_count;
+        // Empty when the neighbors are found at query time
+        bStoresNeighborLinks = Neighbors.Num() > 0 || MortonCodes.Num() == 0;
+    }
+}
+
+void FSVOLayer::Compress( TArray< uint8 > & bytes, const LayerIndex layer_index ) const
+{
+    const auto node_count = GetNodeCount();
+    const uint8 flags = ( HasNeighborLinks() ? 1 : 0 ) | ( HasMortonCodeIndex() ? 2 : 0 );
+
+    WriteVarInt( bytes, node_count );
+    WriteValue( bytes, NodeSize );
+    WriteValue( bytes, flags );
+
+    MortonCode previous_parent_morton_code = 0;
+
+    for ( auto node_index = 0; node_index < node_count; node_index += 8 )
+    {
+        const auto parent_morton_code = MortonCodes[ node_index ] >> 3;
+        WriteVarInt( bytes, parent_morton_code - previous_parent_morton_code );
+        previous_parent_morton_code = parent_morton_code;
+    }
+
+    // The leaves tell which layer 0 nodes have children
+    if ( layer_index == 0 )
+    {
+        return;
+    }
+
+    for ( auto node_index = 0; node_index < node_count; node_index += 8 )
+    {
+        uint8 children_bits = 0;
+
+        for ( auto sibling_index = 0; sibling_index < 8 && node_index + sibling_index < node_count; ++sibling_index )
+        {
+            if ( HasNodeChildren( node_index + sibling_index ) )
+            {
+                children_bits |= 1 << sibling_index;
+            }
+        }
+
+        bytes.Add( children_bits );
+    }
+}
+
+bool FSVOLayer::Decompress( const TArray< uint8 > & bytes, const LayerIndex layer_index, const uint64 max_node_count )
+{
+    FByteReader reader( bytes );
+
+    const auto stored_node_count = reader.ReadVarInt();
+    NodeSize = reader.ReadValue< float >();
+    const auto flags = reader.ReadValue< uint8 >();
+
+    // Each group of siblings takes at least one byte
+    if ( reader.IsError() || stored_node_count > static_cast< uint64 >( bytes.Num() ) * 8 )
+    {
+        return false;
+    }
+
+    const auto node_count = static_cast< int32 >( stored_node_count );
+
+    MaxNodeCount = max_node_count;
+    bStoresNeighborLinks = ( flags & 1 ) != 0;
+
+    MortonCodes.SetNumUninitialized( node_count );
+    FirstChildren.Init( FSVONodeAddress::InvalidAddress, node_count );
+    Parents.Init( FSVONodeAddress::InvalidAddress, node_count );
+    // Filled by FSVOVolumeNavigationData once all the layers are loaded
+    Neighbors.Init( FSVONodeAddress::InvalidAddress, bStoresNeighborLinks ? node_count * 6 : 0 );
+
+    MortonCode parent_morton_code = 0;
+
+    for ( auto node_index = 0; node_index < node_count; node_index += 8 )
+    {
+        parent_morton_code += reader.ReadVarInt();
+        const auto first_morton_code = FSVOHelpers::GetFirstChildMortonCode( parent_morton_code );
+
+        for ( auto sibling_index = 0; sibling_index < 8 && node_index + sibling_index < node_count; ++sibling_index )
+        {
+            MortonCodes[ node_index + sibling_index ] = first_morton_code + sibling_index;
+        }
+    }
+
+    if ( layer_index > 0 )
+    {
+        // The children are stored in the same order as their parents
+        NodeIndex first_child_index = 0;
+
+        for ( auto node_index = 0; node_index < node_count; node_index += 8 )
+        {
+            const auto children_bits = reader.ReadValue< uint8 >();
+
+            for ( auto sibling_index = 0; sibling_index < 8 && node_index + sibling_index < node_count; ++sibling_index )
+            {
+                if ( ( children_bits & 1 << sibling_index ) != 0 )
+                {
+                    FirstChildren[ node_index + sibling_index ] = FSVONodeAddress( static_cast< LayerIndex >( layer_index - 1 ), first_child_index, 0 );
+                    first_child_index += 8;
+                }
+            }
+        }
+    }
+
+    if ( reader.IsError() || !reader.IsAtEnd() )
+    {
+        return false;
+    }
+
+    if ( ( flags & 2 ) != 0 )
+    {
+        BuildMortonCodeIndex();
+    }
+
+    return true;
+}
+
+void FSVOLayer::BuildMortonCodeIndex()
 {
+    MortonCodeIndex.Build( MortonCodes );
 }
 
-int FSVOLayer::GetAllocatedSize() const
+void FSVOLayer::ResetMortonCodeIndex()
 {
-    return Nodes.Num() * sizeof( FSVONode );
+    MortonCodeIndex.Reset();
 }
 
-bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
+bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds, const bool store_neighbor_links )
 {
     Reset();
 
@@ -85,7 +600,8 @@ bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
     const auto voxel_exponent = FMath::CeilToInt( FMath::Log2( volume_size / leaf_size ) );
     const auto layer_count = voxel_exponent + 1;
 
-    if ( layer_count < 2 )
+    // The node addresses store the layer index on 4 bits, and 15 is the invalid layer
+    if ( layer_count < 2 || layer_count > 15 )
     {
         bIsValid = false;
         return false;
@@ -98,10 +614,9 @@ bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
     for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
     {
         const auto layer_edge_node_count = FMath::Pow( 2.0f, voxel_exponent - layer_index );
-        const auto layer_max_node_count = layer_edge_node_count * layer_edge_node_count * layer_edge_node_count; //FMath::CeilToInt( FMath::Pow( layer_edge_node_count, 3 ) );
         const auto layer_voxel_size = navigation_bounds_size / layer_edge_node_count;
 
-        Layers.Emplace( layer_max_node_count, layer_voxel_size );
+        Layers.Emplace( GetLayerMaxNodeCount( voxel_exponent, layer_index ), layer_voxel_size, store_neighbor_links );
     }
 
     NavigationBounds = FBox::BuildAABB( volume_bounds.GetCenter(), FVector( navigation_bounds_size * 0.5f ) );
@@ -111,9 +626,14 @@ bool FSVOData::Initialize( const float voxel_size, const FBox & volume_bounds )
     return true;
 }
 
-void FSVOData::AddBlockedNode( const LayerIndex layer_index, const NodeIndex node_index )
+void FSVOData::AddBlockedNode( const LayerIndex layer_index, const MortonCode morton_code )
 {
-    BlockedNodes[ layer_index ].Add( node_index );
+    BlockedNodes[ layer_index ].Add( morton_code );
+}
+
+void FSVOData::ReleaseBlockedNodes()
+{
+    BlockedNodes.Empty();
 }
 
 FSVOData::FSVOData() :
@@ -124,13 +644,196 @@ FSVOData::FSVOData() :
 
 void FSVOData::Reset()
 {
+    BlockedNodes.Reset();
     Layers.Reset();
     LeafNodes.Reset();
 }
 
-int FSVOData::GetAllocatedSize() const
+void FSVOData::SerializeFlat( FArchive & archive )
 {
-    int size = LeafNodes.GetAllocatedSize();
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOData_SerializeFlat );
+
+    auto layer_count = Layers.Num();
+    archive << layer_count;
+
+    if ( archive.IsLoading() )
+    {
+        // The node addresses store the layer index on 4 bits, and 15 is the invalid layer
+        if ( layer_count < 0 || layer_count > 15 )
+        {
+            archive.SetError();
+            layer_count = 0;
+        }
+
+        Layers.Reset( layer_count );
+        Layers.AddDefaulted( layer_count );
+    }
+
+    const auto voxel_exponent = layer_count - 1;
+
+    for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
+    {
+        Layers[ layer_index ].SerializeFlat( archive, GetLayerMaxNodeCount( voxel_exponent, layer_index ) );
+    }
+
+    LeafNodes.SerializeFlat( archive );
+    archive << NavigationBounds;
+
+    if ( !archive.IsLoading() )
+    {
+        return;
+    }
+
+    bIsValid = !archive.IsError() && layer_count > 0 && NavigationBounds.IsValid && LeafNodes.GetLeafNodeCount() == Layers[ 0 ].GetNodeCount();
+
+    for ( const auto & layer : Layers )
+    {
+        const auto node_count = layer.GetNodeCount();
+
+        if ( layer.FirstChildren.Num() != node_count || layer.Parents.Num() != node_count || layer.HasNeighborLinks() && layer.Neighbors.Num() != node_count * 6 )
+        {
+            bIsValid = false;
+        }
+    }
+
+    if ( !bIsValid )
+    {
+        Reset();
+    }
+}
+
+void FSVOData::SerializeCompressed( FArchive & archive )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOData_SerializeCompressed );
+
+    TArray< TArray< uint8 > > layers_bytes;
+    TArray< uint8 > leaf_nodes_bytes;
+
+    if ( archive.IsSaving() )
+    {
+        layers_bytes.SetNum( Layers.Num() );
+
+        ParallelFor( Layers.Num() + 1, [ & ]( const int32 index ) {
+            if ( index < Layers.Num() )
+            {
+                Layers[ index ].Compress( layers_bytes[ index ], static_cast< LayerIndex >( index ) );
+            }
+            else
+            {
+                LeafNodes.Compress( leaf_nodes_bytes );
+            }
+        } );
+    }
+
+    archive << layers_bytes;
+    archive << leaf_nodes_bytes;
+    archive << NavigationBounds;
+
+    if ( !archive.IsLoading() )
+    {
+        return;
+    }
+
+    // The node addresses store the layer index on 4 bits, and 15 is the invalid layer
+    if ( layers_bytes.Num() > 15 )
+    {
+        archive.SetError();
+    }
+
+    // The data saved before the generation has no layer, and the max node counts can't be computed without the voxel exponent
+    if ( layers_bytes.Num() == 0 || layers_bytes.Num() > 15 )
+    {
+        bIsValid = false;
+        Reset();
+        return;
+    }
+
+    const auto layer_count = layers_bytes.Num();
+    const auto voxel_exponent = layer_count - 1;
+
+    Layers.Reset( layer_count );
+    Layers.AddDefaulted( layer_count );
+
+    // Written by one task each
+    TArray< bool > are_decompressed;
+    are_decompressed.SetNumZeroed( layer_count + 1 );
+
+    ParallelFor( layer_count + 1, [ & ]( const int32 index ) {
+        are_decompressed[ index ] = index < layer_count
+                                        ? Layers[ index ].Decompress( layers_bytes[ index ], static_cast< LayerIndex >( index ), GetLayerMaxNodeCount( voxel_exponent, static_cast< LayerIndex >( index ) ) )
+                                        : LeafNodes.Decompress( leaf_nodes_bytes, GetLayerMaxNodeCount( voxel_exponent, 0 ) );
+    } );
+
+    bIsValid = layer_count > 0 && NavigationBounds.IsValid && !are_decompressed.Contains( false ) && LeafNodes.GetLeafNodeCount() == Layers[ 0 ].GetNodeCount();
+
+    if ( bIsValid )
+    {
+        // Each task writes the parents of the children of its layer. The leaves use the parents of their layer 0 node
+        TArray< bool > are_linked;
+        are_linked.SetNumZeroed( layer_count );
+
+        ParallelFor( layer_count, [ & ]( const int32 layer_index ) {
+            auto & layer = Layers[ layer_index ];
+
+            if ( layer_index == 0 )
+            {
+                // A layer 0 node only links to the leaf which has the same index if some of its sub nodes are occluded
+                for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( layer.GetNodeCount() ); ++node_index )
+                {
+                    if ( !LeafNodes.GetLeafNode( node_index ).IsCompletelyFree() )
+                    {
+                        layer.GetNodeFirstChild( node_index ) = FSVONodeAddress( 0, node_index, 0 );
+                    }
+                }
+
+                are_linked[ layer_index ] = true;
+                return;
+            }
+
+            auto & child_layer = Layers[ layer_index - 1 ];
+
+            for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( layer.GetNodeCount() ); ++node_index )
+            {
+                const auto first_child = layer.GetNodeFirstChild( node_index );
+
+                if ( !first_child.IsValid() )
+                {
+                    continue;
+                }
+
+                if ( first_child.NodeIndex + 8 > static_cast< NodeIndex >( child_layer.GetNodeCount() ) )
+                {
+                    return;
+                }
+
+                const FSVONodeAddress parent_address( static_cast< LayerIndex >( layer_index ), node_index, 0 );
+
+                for ( NodeIndex child_index = 0; child_index < 8; ++child_index )
+                {
+                    child_layer.GetNodeParent( first_child.NodeIndex + child_index ) = parent_address;
+                }
+            }
+
+            are_linked[ layer_index ] = true;
+        } );
+
+        bIsValid = !are_linked.Contains( false );
+    }
+
+    if ( !bIsValid )
+    {
+        Reset();
+    }
+}
+
+int64 FSVOData::GetAllocatedSize() const
+{
+    int64 size = LeafNodes.GetAllocatedSize() + Layers.GetAllocatedSize() + BlockedNodes.GetAllocatedSize();
+
+    for ( const auto & layer_blocked_nodes : BlockedNodes )
+    {
+        size += layer_blocked_nodes.GetAllocatedSize();
+    }
 
     for ( const auto & layer : Layers )
     {
@@ -0,0 +1,129 @@
+#include "Raycasters/SVORaycaster_OctreeTraversal.h"
+#include "SVONavigationData.h"
+#include "SVOVolumeNavigationData.h"
+
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+
+namespace
+{
+    // Measures the queries which walk the octree, to compare the memory layouts of the nodes on the same maps
+    void BenchmarkVolumeQueries( const FSVOVolumeNavigationData & volume_navigation_data, const USVORayCaster & ray_caster, const int32 ray_count )
+    {
+        const auto & data = volume_navigation_data.GetData();
+
+        if ( !data.IsValid() )
+        {
+            return;
+        }
+
+        TArray< FSVONodeAddress > neighbors;
+        int32 node_count = 0;
+        int32 neighbor_count = 0;
+
+        auto start_time = FPlatformTime::Seconds();
+
+        for ( LayerIndex layer_index = 0; layer_index < data.GetLayerCount(); ++layer_index )
+        {
+            const auto & layer = data.GetLayer( layer_index );
+
+            for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( layer.GetNodeCount() ); ++node_index )
+            {
+                neighbors.Reset();
+                volume_navigation_data.GetNodeNeighbors( neighbors, FSVONodeAddress( layer_index, node_index, 0 ) );
+                neighbor_count += neighbors.Num();
+                node_count++;
+            }
+        }
+
+        const auto neighbors_time = FPlatformTime::Seconds() - start_time;
+
+        // Always the same rays, so the results of several runs can be compared
+        FRandomStream random_stream( 0 );
+        const auto & navigation_bounds = data.GetNavigationBounds();
+        int32 hit_count = 0;
+
+        // The start and the end of each ray
+        TArray< FVector > positions;
+        positions.Reserve( ray_count * 2 );
+
+        for ( auto position_index = 0; position_index < ray_count * 2; ++position_index )
+        {
+            positions.Emplace( random_stream.RandPointInBox( navigation_bounds ) );
+        }
+
+        start_time = FPlatformTime::Seconds();
+
+        for ( auto ray_index = 0; ray_index < ray_count; ++ray_index )
+        {
+            if ( ray_caster.Trace( volume_navigation_data, positions[ ray_index * 2 ], positions[ ray_index * 2 + 1 ] ) )
+            {
+                hit_count++;
+            }
+        }
+
+        const auto ray_casts_time = FPlatformTime::Seconds() - start_time;
+
+        FSVONodeAddress node_address;
+        int32 found_node_count = 0;
+
+        start_time = FPlatformTime::Seconds();
+
+        for ( const auto & position : positions )
+        {
+            if ( volume_navigation_data.GetNodeAddressFromPosition( node_address, position ) )
+            {
+                found_node_count++;
+            }
+        }
+
+        const auto node_addresses_time = FPlatformTime::Seconds() - start_time;
+
+        TArray< FSVONodeAddressFromPosition > node_addresses;
+
+        start_time = FPlatformTime::Seconds();
+        volume_navigation_data.GetNodeAddressesFromPositions( node_addresses, positions );
+        const auto batched_node_addresses_time = FPlatformTime::Seconds() - start_time;
+
+        UE_LOG( LogNavigation,
+            Display,
+            TEXT( "Volume %s : neighbors of %d nodes in %.2fms (%.1fns per node, %d neighbors) - %d ray casts in %.2fms (%.2fus per ray, %d hits) - %d node addresses in %.2fms, %.2fms batched (%d free)" ),
+            *volume_navigation_data.GetVolumeBounds().ToString(),
+            node_count,
+            neighbors_time * 1000.0,
+            node_count > 0 ? neighbors_time * 1000000000.0 / node_count : 0.0,
+            neighbor_count,
+            ray_count,
+            ray_casts_time * 1000.0,
+            ray_count > 0 ? ray_casts_time * 1000000.0 / ray_count : 0.0,
+            hit_count,
+            positions.Num(),
+            node_addresses_time * 1000.0,
+            batched_node_addresses_time * 1000.0,
+            found_node_count );
+    }
+
+    void BenchmarkQueries( const TArray< FString > & arguments, UWorld * world )
+    {
+        if ( world == nullptr )
+        {
+            return;
+        }
+
+        const auto ray_count = arguments.Num() > 0 ? FCString::Atoi( *arguments[ 0 ] ) : 10000;
+        const auto * ray_caster = NewObject< USVORayCaster_OctreeTraversal >();
+
+        for ( TActorIterator< ASVONavigationData > iterator( world ); iterator; ++iterator )
+        {
+            for ( const auto & volume_navigation_data : iterator->GetVolumeNavigationData() )
+            {
+                BenchmarkVolumeQueries( volume_navigation_data, *ray_caster, ray_count );
+            }
+        }
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs BenchmarkQueriesCommand(
+        TEXT( "SVONavigation.BenchmarkQueries" ),
+        TEXT( "Measures the time to get the neighbors of all the nodes, to cast random rays with the octree traversal ray caster, and to find the nodes of the ends of the rays, in each volume of the SVO navigation data. Takes the number of rays, 10000 by default." ),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic( &BenchmarkQueries ) );
+}
@@ -1,12 +1,21 @@
 #include "SVOVolumeNavigationData.h"
 
+#include "SVOGeometrySnapshot.h"
 #include "SVOHelpers.h"
 #include "SVONavigationData.h"
+#include "SVONavigationSettings.h"
 #include "SVONavigationTypes.h"
 #include "SVOVersion.h"
 
+#include <Algo/BinarySearch.h>
+#include <Algo/Unique.h>
+#include <Async/ParallelFor.h>
+#include <Components/InstancedStaticMeshComponent.h>
+#include <Misc/ScopeExit.h>
 #include <ThirdParty/libmorton/morton.h>
 
+#include <atomic>
+
 namespace
 {
     const FIntVector NeighborDirections[ 6 ] = {
@@ -17,6 +26,15 @@ namespace
         { 0, 0, 1 },
         { 0, 0, -1 }
     };
+
+    // The batched node queries are split in tasks of at least that many positions. Below that, scheduling the task costs more than the searches
+    constexpr int32 MinPositionCountPerTask = 1024;
+
+    // The sub node morton codes use at most 3 * 16 bits, so this is greater than any of them
+    constexpr MortonCode OutOfBoundsMortonCode = MAX_uint64;
+
+    // The volumes are generated on worker threads
+    std::atomic< uint64 > NextOctreeId( 1 );
 }
 
 FSVOVolumeNavigationDataGenerationSettings::FSVOVolumeNavigationDataGenerationSettings() :
@@ -25,20 +43,33 @@ FSVOVolumeNavigationDataGenerationSettings::FSVOVolumeNavigationDataGenerationSe
 {
 }
 
+FSVONodeAddressFromPosition::FSVONodeAddressFromPosition() :
+    VolumeIndex( INDEX_NONE ),
+    NodeRef( INVALID_NAVNODEREF ),
+    bIsOccluded( false )
+{
+}
+
+FSVOVolumeNavigationData::FSVOVolumeNavigationData() :
+    VolumeBounds( ForceInit ),
+    SVOData( MakeShared< FSVOData, ESPMode::ThreadSafe >() ),
+    OctreeId( 0 ),
+    Serial( 0 ),
+    DynamicObstacles( MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >() ),
+    bInNavigationDataChunk( false )
+{
+}
+
 FVector FSVOVolumeNavigationData::GetNodePositionFromAddress( const FSVONodeAddress & address, const bool try_get_sub_node_position ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodePositionFromNodeAddress );
 
     if ( address.LayerIndex == 0 )
     {
-        // Leaf nodes don't have the same NodeIndex as other nodes. They map to the index of the array of leaf nodes.
-        // We must then re-construct the leaf node position based on that leaf node parent.
-        const auto & leaf_nodes = SVOData.GetLeafNodes();
-        const auto & leaf_node = leaf_nodes.GetLeafNode( address.NodeIndex );        
-        const auto & leaf_node_parent_node = SVOData.GetLayer( 1 ).GetNode( leaf_node.Parent.NodeIndex );
-        
-        const auto child_index_offset = address.NodeIndex - leaf_node_parent_node.FirstChild.NodeIndex;
-        const auto leaf_node_morton_code = FSVOHelpers::GetFirstChildMortonCode( leaf_node_parent_node.MortonCode ) + child_index_offset;
+        // Leaf nodes have the index of their layer 0 node
+        const auto & leaf_nodes = SVOData->GetLeafNodes();
+        const auto leaf_node = leaf_nodes.GetLeafNode( address.NodeIndex );
+        const auto leaf_node_morton_code = SVOData->GetLayer( 0 ).GetNodeMortonCode( address.NodeIndex );
         const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
 
         const FVector leaf_node_position = GetLeafNodePositionFromMortonCode( leaf_node_morton_code );
@@ -54,15 +85,14 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromAddress( const FSVONodeAddr
         return sub_node_position;
     }
 
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
 
-    const auto & layer = SVOData.GetLayer( address.LayerIndex );
+    const auto & layer = SVOData->GetLayer( address.LayerIndex );
     const auto layer_node_size = layer.GetNodeSize();
     const auto layer_node_extent = layer.GetNodeExtent();
-    const auto & node = layer.GetNode( address.NodeIndex );
-    const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( node.MortonCode );
+    const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( layer.GetNodeMortonCode( address.NodeIndex ) );
 
     const auto position = navigation_bounds_center - navigation_bounds_extent + morton_coords * layer_node_size + layer_node_extent;
 
@@ -76,9 +106,9 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromLayerAndMortonCode( const L
         return GetLeafNodePositionFromMortonCode( morton_code );
     }
 
-    const auto & layer = SVOData.GetLayer( layer_index );
+    const auto & layer = SVOData->GetLayer( layer_index );
     const auto layer_node_extent = layer.GetNodeExtent();
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
     const auto layer_node_size = layer.GetNodeSize();
@@ -89,10 +119,10 @@ FVector FSVOVolumeNavigationData::GetNodePositionFromLayerAndMortonCode( const L
 
 FVector FSVOVolumeNavigationData::GetLeafNodePositionFromMortonCode( const MortonCode morton_code ) const
 {
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
     const auto navigation_bounds_center = navigation_bounds.GetCenter();
     const auto navigation_bounds_extent = navigation_bounds.GetExtent();
-    const auto & leaf_nodes = SVOData.GetLeafNodes();
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
     const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
     const auto leaf_node_size = leaf_nodes.GetLeafNodeSize();
     const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( morton_code );
@@ -103,115 +133,188 @@ FVector FSVOVolumeNavigationData::GetLeafNodePositionFromMortonCode( const Morto
 
 bool FSVOVolumeNavigationData::GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position ) const
 {
-    const auto & navigation_bounds = SVOData.GetNavigationBounds();
-
-    if ( !navigation_bounds.IsInside( position ) )
+    if ( !SVOData->GetNavigationBounds().IsInside( position ) || SVOData->GetLastLayer().GetNodeCount() == 0 )
     {
         return false;
     }
 
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodeAddressFromPosition );
 
-    FVector origin;
-    FVector extent;
+    TStaticArray< NodeIndex, 16 > layer_node_indices;
+    layer_node_indices[ GetLayerCount() - 1 ] = 0;
+    LayerIndex last_layer_index;
 
-    navigation_bounds.GetCenterAndExtents( origin, extent );
-    // The z-order origin of the volume (where code == 0)
-    const auto z_origin = origin - extent;
-    // The local position of the point in volume space
-    const auto local_position = position - z_origin;
+    return GetNodeAddressFromSubNodeMortonCode( node_address, last_layer_index, layer_node_indices, GetLayerCount() - 1, GetSubNodeMortonCodeFromPosition( position ) );
+}
 
-    const auto layer_count = GetLayerCount();
-    LayerIndex layer_index = layer_count - 1;
-    NodeIndex nodeIndex = 0;
+void FSVOVolumeNavigationData::GetNodeAddressesFromPositions( TArray< FSVONodeAddressFromPosition > & results, const TArray< FVector > & positions ) const
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodeAddressesFromPositions );
 
-    while ( layer_index >= 0 && layer_index < layer_count )
+    results.Reset( positions.Num() );
+    results.SetNum( positions.Num() );
+
+    if ( !SVOData->IsValid() || SVOData->GetLastLayer().GetNodeCount() == 0 )
     {
-        const auto & layer = SVOData.GetLayer( layer_index );
-        const auto & layer_nodes = layer.GetNodes();
-        const auto voxel_size = layer.GetNodeSize();
+        return;
+    }
 
-        FIntVector voxel_coords;
-        voxel_coords.X = FMath::FloorToInt( local_position.X / voxel_size );
-        voxel_coords.Y = FMath::FloorToInt( local_position.Y / voxel_size );
-        voxel_coords.Z = FMath::FloorToInt( local_position.Z / voxel_size );
+    TArray< TPair< MortonCode, int32 > > sorted_positions;
+    GetSortedSubNodeMortonCodesFromPositions( sorted_positions, positions );
 
-        // Get the morton code we want for this layer
-        const auto code = FSVOHelpers::GetMortonCodeFromVector( voxel_coords );
-        const auto node_extent = layer.GetNodeExtent();
+    const auto top_layer_index = static_cast< LayerIndex >( GetLayerCount() - 1 );
+    const auto task_count = FMath::DivideAndRoundUp( sorted_positions.Num(), MinPositionCountPerTask );
 
-        for ( NodeIndex node_index = nodeIndex; node_index < static_cast< uint32 >( layer_nodes.Num() ); node_index++ )
-        {
-            const auto & node = layer_nodes[ node_index ];
+    // Each task searches a contiguous range of the sorted positions, and only writes the results of those positions
+    ParallelFor( task_count, [ & ]( const int32 task_index ) {
+        const auto first_sorted_index = task_index * MinPositionCountPerTask;
+        const auto end_sorted_index = FMath::Min( first_sorted_index + MinPositionCountPerTask, sorted_positions.Num() );
 
-            // This is the node we are in
-            if ( node.MortonCode != code )
-            {
-                continue;
-            }
+        TStaticArray< NodeIndex, 16 > layer_node_indices;
+        layer_node_indices[ top_layer_index ] = 0;
+        LayerIndex last_layer_index = top_layer_index;
 
-            // There are no child nodes, so this is our nav position
-            if ( !node.FirstChild.IsValid() ) // && layerIndex > 0)
-            {
-                node_address.LayerIndex = layer_index;
-                node_address.NodeIndex = node_index;
-                node_address.SubNodeIndex = 0;
-                return true;
-            }
+        for ( auto sorted_index = first_sorted_index; sorted_index < end_sorted_index; ++sorted_index )
+        {
+            const auto code = sorted_positions[ sorted_index ].Key;
+            auto & result = results[ sorted_positions[ sorted_index ].Value ];
+            auto start_layer_index = top_layer_index;
 
-            // If this is a leaf node, we need to find our subnode
-            if ( layer_index == 0 )
+            if ( sorted_index > first_sorted_index )
             {
-                const auto & leaf_nodes = SVOData.GetLeafNodes();
-                const auto & leaf = leaf_nodes.GetLeafNode( node.FirstChild.NodeIndex );
-
-                // We need to calculate the node local position to get the morton code for the leaf
-                // The world position of the 0 node
-                const auto node_position = GetLeafNodePositionFromMortonCode( node.MortonCode );
-                // The morton origin of the node
-                const auto node_origin = node_position - FVector( node_extent );
-                // The requested position, relative to the node origin
-                const auto node_local_position = position - node_origin;
-                // Now get our voxel coordinates
-                const auto voxel_quarter_size = voxel_size * 0.25f;
-
-                FIntVector leaf_coords;
-                leaf_coords.X = FMath::FloorToInt( node_local_position.X / voxel_quarter_size );
-                leaf_coords.Y = FMath::FloorToInt( node_local_position.Y / voxel_quarter_size );
-                leaf_coords.Z = FMath::FloorToInt( node_local_position.Z / voxel_quarter_size );
-
-                node_address.LayerIndex = 0;
-                node_address.NodeIndex = node_index;
-
-                const auto leaf_code = FSVOHelpers::GetMortonCodeFromVector( leaf_coords ); // This morton code is our key into the 64-bit leaf node
-
-                if ( leaf.IsSubNodeOccluded( leaf_code ) )
+                const auto previous_code = sorted_positions[ sorted_index - 1 ].Key;
+
+                if ( code == previous_code )
                 {
-                    return false; // This voxel is blocked
+                    result = results[ sorted_positions[ sorted_index - 1 ].Value ];
+                    continue;
                 }
 
-                node_address.SubNodeIndex = leaf_code;
-
-                return true;
+                // Start from the deepest node of the previous search which also contains this position
+                const auto highest_different_bit = 63 - FMath::CountLeadingZeros64( code ^ previous_code );
+                const auto shared_layer_index = highest_different_bit < 6 ? 0 : ( highest_different_bit - 6 ) / 3 + 1;
+                start_layer_index = static_cast< LayerIndex >( FMath::Clamp< int32 >( shared_layer_index, last_layer_index, top_layer_index ) );
             }
 
-            // If we've got here, the current node has a child, and isn't a leaf, so lets go down...
-            layer_index = layer_nodes[ node_index ].FirstChild.LayerIndex;
-            nodeIndex = layer_nodes[ node_index ].FirstChild.NodeIndex;
+            result.bIsOccluded = !GetNodeAddressFromSubNodeMortonCode( result.NodeAddress, last_layer_index, layer_node_indices, start_layer_index, code );
+        }
+    } );
+}
+
+MortonCode FSVOVolumeNavigationData::GetSubNodeMortonCodeFromPosition( const FVector & position ) const
+{
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
+    const auto sub_node_size = SVOData->GetLeafNodes().GetLeafSubNodeSize();
+    // 4 sub nodes per leaf node on each axis
+    const auto max_coordinate = ( 4 << ( GetLayerCount() - 1 ) ) - 1;
+    const auto local_position = ( position - navigation_bounds.Min ) / sub_node_size;
+
+    const FIntVector sub_node_coords(
+        FMath::Clamp( FMath::FloorToInt( local_position.X ), 0, max_coordinate ),
+        FMath::Clamp( FMath::FloorToInt( local_position.Y ), 0, max_coordinate ),
+        FMath::Clamp( FMath::FloorToInt( local_position.Z ), 0, max_coordinate ) );
+
+    return FSVOHelpers::GetMortonCodeFromVector( sub_node_coords );
+}
+
+void FSVOVolumeNavigationData::GetSortedSubNodeMortonCodesFromPositions( TArray< TPair< MortonCode, int32 > > & sorted_positions, const TArray< FVector > & positions ) const
+{
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
+
+    sorted_positions.SetNumUninitialized( positions.Num() );
+
+    // Only computes the codes, so the loop stays tight. The positions outside the bounds get a code greater than all the others
+    ParallelFor( FMath::DivideAndRoundUp( positions.Num(), MinPositionCountPerTask ), [ & ]( const int32 task_index ) {
+        const auto first_position_index = task_index * MinPositionCountPerTask;
+        const auto end_position_index = FMath::Min( first_position_index + MinPositionCountPerTask, positions.Num() );
 
-            break; //stop iterating this layer
+        for ( auto position_index = first_position_index; position_index < end_position_index; ++position_index )
+        {
+            const auto & position = positions[ position_index ];
+
+            sorted_positions[ position_index ] = TPair< MortonCode, int32 >(
+                navigation_bounds.IsInside( position ) ? GetSubNodeMortonCodeFromPosition( position ) : OutOfBoundsMortonCode,
+                position_index );
         }
-    }
+    } );
+
+    // Consecutive positions then share the nodes of the upper layers, and the nodes are visited in the order they are stored
+    sorted_positions.Sort( []( const TPair< MortonCode, int32 > & left, const TPair< MortonCode, int32 > & right ) {
+        return left.Key < right.Key;
+    } );
 
-    return false;
+    const auto in_bounds_position_count = Algo::LowerBoundBy( sorted_positions, OutOfBoundsMortonCode, []( const TPair< MortonCode, int32 > & sorted_position ) {
+        return sorted_position.Key;
+    } );
+
+    sorted_positions.SetNum( in_bounds_position_count, false );
+}
+
+bool FSVOVolumeNavigationData::GetNodeAddressFromSubNodeMortonCode( FSVONodeAddress & node_address, LayerIndex & last_layer_index, TStaticArray< NodeIndex, 16 > & layer_node_indices, const LayerIndex start_layer_index, const MortonCode sub_node_morton_code ) const
+{
+    auto layer_index = start_layer_index;
+    auto node_index = layer_node_indices[ layer_index ];
+
+    while ( true )
+    {
+        layer_node_indices[ layer_index ] = node_index;
+        last_layer_index = layer_index;
+
+        const auto & first_child = SVOData->GetLayer( layer_index ).GetNodeFirstChild( node_index );
+
+        // The node is completely free
+        if ( !first_child.IsValid() )
+        {
+            node_address = FSVONodeAddress( layer_index, node_index, 0 );
+            return !DynamicObstacles->IsNodeBlocked( node_address );
+        }
+
+        if ( layer_index == 0 )
+        {
+            // The lowest 6 bits are the index of the sub node in the leaf
+            const auto sub_node_index = static_cast< SubNodeIndex >( sub_node_morton_code & 63 );
+            node_address = FSVONodeAddress( 0, node_index, sub_node_index );
+
+            if ( SVOData->GetLeafNodes().GetLeafNode( first_child.NodeIndex ).IsSubNodeOccluded( sub_node_index ) )
+            {
+                return false;
+            }
+
+            return !DynamicObstacles->IsNodeBlocked( node_address );
+        }
+
+        // The children are sorted by morton code, so the octant of the position in the node is the offset of its child
+        --layer_index;
+        node_index = first_child.NodeIndex + ( sub_node_morton_code >> ( 6 + 3 * layer_index ) & 7 );
+    }
 }
 
 void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNeighbors );
 
-    const auto & node = GetNodeFromAddress( node_address );
-    if ( node_address.LayerIndex == 0 && node.FirstChild.IsValid() )
+    const auto first_neighbor_index = neighbors.Num();
+
+    ON_SCOPE_EXIT
+    {
+        if ( !DynamicObstacles->IsEmpty() )
+        {
+            for ( auto neighbor_index = neighbors.Num() - 1; neighbor_index >= first_neighbor_index; --neighbor_index )
+            {
+                if ( DynamicObstacles->IsNodeBlocked( neighbors[ neighbor_index ] ) )
+                {
+                    neighbors.RemoveAt( neighbor_index, 1, false );
+                }
+            }
+        }
+    };
+
+    // Only the child and neighbor links are read, so only their arrays are loaded in the cache
+    const LayerIndex layer_index = node_address.IsValid() ? node_address.LayerIndex : GetLayerCount() - 1;
+    const auto & layer = SVOData->GetLayer( layer_index );
+    const auto node_index = node_address.IsValid() ? node_address.NodeIndex : 0;
+
+    if ( node_address.LayerIndex == 0 && layer.HasNodeChildren( node_index ) )
     {
         GetLeafNeighbors( neighbors, node_address );
         return;
@@ -219,16 +322,16 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
 
     for ( NeighborDirection neighbor_direction = 0; neighbor_direction < 6; neighbor_direction++ )
     {
-        const auto & neighbor_address = node.Neighbors[ neighbor_direction ];
+        const auto neighbor_address = GetNodeNeighbor( layer_index, node_index, neighbor_direction );
 
         if ( !neighbor_address.IsValid() )
         {
             continue;
         }
 
-        const auto & neighbor = GetNodeFromAddress( neighbor_address );
+        const auto & neighbor_first_child = SVOData->GetLayer( neighbor_address.LayerIndex ).GetNodeFirstChild( neighbor_address.NodeIndex );
 
-        if ( !neighbor.HasChildren() )
+        if ( !neighbor_first_child.IsValid() )
         {
             neighbors.Add( neighbor_address );
             continue;
@@ -242,10 +345,10 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
             // Pop off the top of the working set
             auto this_address = neighbor_addresses_working_set.Pop();
 
-            const auto & this_node = GetNodeFromAddress( this_address );
+            const auto & this_node_first_child = SVOData->GetLayer( this_address.LayerIndex ).GetNodeFirstChild( this_address.NodeIndex );
 
             // If the node as no children, it's clear, so add to neighbors and continue
-            if ( !this_node.HasChildren() )
+            if ( !this_node_first_child.IsValid() )
             {
                 neighbors.Add( neighbor_address );
                 continue;
@@ -275,13 +378,14 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
                 };
 
                 // If it's above layer 0, we will need to potentially add 4 children using our offsets
+                const auto & child_layer = SVOData->GetLayer( this_node_first_child.LayerIndex );
+
                 for ( const auto & child_index : ChildOffsetsDirections[ neighbor_direction ] )
                 {
-                    auto first_child_address = this_node.FirstChild;
+                    auto first_child_address = this_node_first_child;
                     first_child_address.NodeIndex += child_index;
-                    const auto & child_node = GetNodeFromAddress( first_child_address );
 
-                    if ( child_node.HasChildren() ) // If it has children, add them to the working set to keep going down
+                    if ( child_layer.HasNodeChildren( first_child_address.NodeIndex ) ) // If it has children, add them to the working set to keep going down
                     {
                         neighbor_addresses_working_set.Emplace( first_child_address );
                     }
@@ -320,8 +424,8 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
                 for ( const auto & leaf_index : LeafChildOffsetsDirections[ neighbor_direction ] )
                 {
                     // Each of the childnodes
-                    auto first_child_address = neighbor.FirstChild;
-                    const auto & leaf_node = SVOData.GetLeafNodes().GetLeafNode( first_child_address.NodeIndex );
+                    auto first_child_address = neighbor_first_child;
+                    const auto & leaf_node = SVOData->GetLeafNodes().GetLeafNode( first_child_address.NodeIndex );
 
                     first_child_address.LayerIndex = 0;
                     first_child_address.NodeIndex = this_address.NodeIndex;
@@ -337,6 +441,17 @@ void FSVOVolumeNavigationData::GetNodeNeighbors( TArray< FSVONodeAddress > & nei
     }
 }
 
+bool FSVOVolumeNavigationData::ContainsNodeAddress( const FSVONodeAddress & address ) const
+{
+    if ( !address.IsValid() || static_cast< int32 >( address.LayerIndex ) >= GetLayerCount() )
+    {
+        return false;
+    }
+
+    // Layer 0 nodes have the index of their leaf node
+    return address.NodeIndex < static_cast< uint32 >( SVOData->GetLayer( address.LayerIndex ).GetNodeCount() );
+}
+
 float FSVOVolumeNavigationData::GetLayerRatio( const LayerIndex layer_index ) const
 {
     return static_cast< float >( layer_index ) / GetLayerCount();
@@ -351,7 +466,7 @@ float FSVOVolumeNavigationData::GetNodeExtentFromNodeAddress( const FSVONodeAddr
 {
     if ( node_address.LayerIndex == 0 )
     {
-        const auto & leaf_nodes = SVOData.GetLeafNodes();
+        const auto & leaf_nodes = SVOData->GetLeafNodes();
         const auto & leaf_node = leaf_nodes.GetLeafNode( node_address.NodeIndex );
         if ( leaf_node.IsCompletelyFree() )
         {
@@ -361,10 +476,10 @@ float FSVOVolumeNavigationData::GetNodeExtentFromNodeAddress( const FSVONodeAddr
         return leaf_nodes.GetLeafSubNodeExtent();
     }
 
-    return SVOData.GetLayer( node_address.LayerIndex ).GetNodeExtent();
+    return SVOData->GetLayer( node_address.LayerIndex ).GetNodeExtent();
 }
 
-TOptional< FNavLocation > FSVOVolumeNavigationData::GetRandomPoint() const
+TOptional< FNavLocation > FSVOVolumeNavigationData::GetRandomPoint( const int32 volume_index ) const
 {
     TArray< FSVONodeAddress > non_occluded_nodes;
     const FSVONodeAddress top_most_node_address( GetLayerCount(), 0, 0 );
@@ -383,53 +498,273 @@ TOptional< FNavLocation > FSVOVolumeNavigationData::GetRandomPoint() const
 
     const auto node_bounds = FBox::BuildAABB( random_node_location, FVector( random_node_extent ) );
     const auto random_point_in_node = FMath::RandPointInBox( node_bounds );
-    return FNavLocation( random_point_in_node, random_node.GetNavNodeRef() );
+    return FNavLocation( random_point_in_node, GetNavNodeRef( random_node, volume_index ) );
 }
 
 void FSVOVolumeNavigationData::GenerateNavigationData( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GenerateNavigationData );
+    SCOPE_CYCLE_COUNTER( STAT_SVONavigation_GenerateVolume );
+    LLM_SCOPE_BYTAG( SVONavigation );
 
     Settings = generation_settings;
     VolumeBounds = volume_bounds;
+    DynamicObstacles = MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >();
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+    ChangeOctreeId();
 
     const auto voxel_extent = Settings.VoxelExtent;
 
-    if ( !SVOData.Initialize( voxel_extent, VolumeBounds ) )
+    if ( !SVOData->Initialize( voxel_extent, VolumeBounds, Settings.GenerationSettings.bStoreNeighborLinks ) )
     {
         return;
     }
 
-    const auto layer_count = SVOData.GetLayerCount();
-
     FirstPassRasterization();
+    BuildOctree( FReusableLeafNodes() );
+}
+
+void FSVOVolumeNavigationData::UpdateNavigationData( const TArray< FBox > & dirty_areas, const FSVOVolumeNavigationDataGenerationSettings & generation_settings )
+{
+    SCOPE_CYCLE_COUNTER( STAT_SVONavigation_UpdateVolume );
+    LLM_SCOPE_BYTAG( SVONavigation );
 
+    // The settings are not serialized, but the size of the leaf nodes tells which voxel extent was used to generate the data
+    if ( !SVOData->IsValid() || !FMath::IsNearlyEqual( SVOData->GetLeafNodes().GetLeafNodeSize(), generation_settings.VoxelExtent * 4.0f ) )
     {
-        QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_AllocateLeafNodes );
-        const auto leaf_count = SVOData.GetLayerBlockedNodes( 0 ).Num() * 8;
-        SVOData.GetLeafNodes().AllocateLeafNodes( leaf_count );
+        GenerateNavigationData( VolumeBounds, generation_settings );
+        return;
     }
 
-    TMap< LeafIndex, MortonCode > leaf_index_to_parent_morton_code;
-    RasterizeInitialLayer( leaf_index_to_parent_morton_code );
+    Settings = generation_settings;
+    DynamicObstacles = MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >();
+
+    TArray< MortonCode > dirty_morton_codes;
+    GetDirtyLayerOneMortonCodes( dirty_morton_codes, dirty_areas );
+
+    FReusableLeafNodes reusable_leaf_nodes;
 
-    for ( LayerIndex layer_index = 1; layer_index < layer_count; ++layer_index )
     {
-        RasterizeLayer( layer_index );
+        // The nodes of a layer are sorted by morton code, so are the reusable ones
+        const auto & leaf_nodes = SVOData->GetLeafNodes();
+        const auto & layer_one = SVOData->GetLayer( 1 );
+
+        for ( NodeIndex node_index = 0; node_index < static_cast< NodeIndex >( layer_one.GetNodeCount() ); ++node_index )
+        {
+            const auto morton_code = layer_one.GetNodeMortonCode( node_index );
+
+            if ( !layer_one.HasNodeChildren( node_index ) || Algo::BinarySearch( dirty_morton_codes, morton_code ) != INDEX_NONE )
+            {
+                continue;
+            }
+
+            reusable_leaf_nodes.LayerOneMortonCodes.Add( morton_code );
+
+            for ( auto child_index = 0; child_index < 8; ++child_index )
+            {
+                reusable_leaf_nodes.SubNodes.Add( leaf_nodes.GetLeafNode( layer_one.GetNodeFirstChild( node_index ).NodeIndex + child_index ).SubNodes );
+            }
+        }
     }
 
-    BuildParentLinkForLeafNodes( leaf_index_to_parent_morton_code );
+    // The copies of this object which share the previous data keep it unchanged
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+    ChangeOctreeId();
 
-    for ( LayerIndex layer_index = layer_count - 2; layer_index != static_cast< LayerIndex >( -1 ); --layer_index )
+    if ( !SVOData->Initialize( Settings.VoxelExtent, VolumeBounds, Settings.GenerationSettings.bStoreNeighborLinks ) )
     {
-        BuildNeighborLinks( layer_index );
+        return;
     }
 
-    SVOData.bIsValid = true;
+    {
+        SCOPE_CYCLE_COUNTER( STAT_SVONavigation_FirstPassRasterization );
+
+        const auto layer_one_node_extent = SVOData->GetLayer( 1 ).GetNodeExtent();
+        TArray< bool > are_dirty_nodes_occluded;
+        are_dirty_nodes_occluded.SetNumZeroed( dirty_morton_codes.Num() );
+
+        BeginGenerationPhase( ESVOGenerationPhase::FirstPass, dirty_morton_codes.Num() );
+
+        ParallelFor(
+            dirty_morton_codes.Num(),
+            [ & ]( const int32 index ) {
+                if ( IsGenerationCancelled() )
+                {
+                    return;
+                }
+
+                are_dirty_nodes_occluded[ index ] = IsPositionOccluded( GetNodePositionFromLayerAndMortonCode( 1, dirty_morton_codes[ index ] ), layer_one_node_extent );
+                AddGenerationProcessedNodes( 1 );
+            },
+            Settings.GenerationSettings.bUseParallelRasterization
+                ? EParallelForFlags::None
+                : EParallelForFlags::ForceSingleThread );
+
+        // Merge the reusable nodes with the occluded dirty nodes. Both are sorted, and don't share any morton code
+        const auto & reusable_morton_codes = reusable_leaf_nodes.LayerOneMortonCodes;
+        int32 reusable_index = 0;
+
+        for ( auto dirty_index = 0; dirty_index < dirty_morton_codes.Num(); ++dirty_index )
+        {
+            for ( ; reusable_index < reusable_morton_codes.Num() && reusable_morton_codes[ reusable_index ] < dirty_morton_codes[ dirty_index ]; ++reusable_index )
+            {
+                SVOData->AddBlockedNode( 0, reusable_morton_codes[ reusable_index ] );
+            }
+
+            if ( are_dirty_nodes_occluded[ dirty_index ] )
+            {
+                SVOData->AddBlockedNode( 0, dirty_morton_codes[ dirty_index ] );
+            }
+        }
+
+        for ( ; reusable_index < reusable_morton_codes.Num(); ++reusable_index )
+        {
+            SVOData->AddBlockedNode( 0, reusable_morton_codes[ reusable_index ] );
+        }
+    }
+
+    // The layers and the links are built again for the whole volume: adding or removing the children of a node shifts the indices of all the nodes after it in the layer, which the links point to.
+    // Only the rasterization above is limited to the dirty areas
+    BuildOctree( reusable_leaf_nodes );
+}
+
+void FSVOVolumeNavigationData::GetDirtyLayerOneMortonCodes( TArray< MortonCode > & morton_codes, const TArray< FBox > & dirty_areas ) const
+{
+    const auto & navigation_bounds = SVOData->GetNavigationBounds();
+    const auto layer_one_node_size = SVOData->GetLayer( 1 ).GetNodeSize();
+    const auto max_coord = FMath::RoundToInt( navigation_bounds.GetSize().X / layer_one_node_size ) - 1;
+
+    for ( const auto & dirty_area : dirty_areas )
+    {
+        // The boxes used to rasterize the nodes are expanded by the clearance, so the geometry also affects the nodes around it
+        const auto expanded_dirty_area = dirty_area.ExpandBy( Settings.GenerationSettings.Clearance );
+
+        if ( !expanded_dirty_area.Intersect( navigation_bounds ) )
+        {
+            continue;
+        }
+
+        const auto min_coords = ( expanded_dirty_area.Min - navigation_bounds.Min ) / layer_one_node_size;
+        const auto max_coords = ( expanded_dirty_area.Max - navigation_bounds.Min ) / layer_one_node_size;
+        const FIntVector min_node_coords( FMath::Clamp( FMath::FloorToInt( min_coords.X ), 0, max_coord ), FMath::Clamp( FMath::FloorToInt( min_coords.Y ), 0, max_coord ), FMath::Clamp( FMath::FloorToInt( min_coords.Z ), 0, max_coord ) );
+        const FIntVector max_node_coords( FMath::Clamp( FMath::FloorToInt( max_coords.X ), 0, max_coord ), FMath::Clamp( FMath::FloorToInt( max_coords.Y ), 0, max_coord ), FMath::Clamp( FMath::FloorToInt( max_coords.Z ), 0, max_coord ) );
+
+        for ( auto z = min_node_coords.Z; z <= max_node_coords.Z; ++z )
+        {
+            for ( auto y = min_node_coords.Y; y <= max_node_coords.Y; ++y )
+            {
+                for ( auto x = min_node_coords.X; x <= max_node_coords.X; ++x )
+                {
+                    morton_codes.Add( FSVOHelpers::GetMortonCodeFromVector( FIntVector( x, y, z ) ) );
+                }
+            }
+        }
+    }
+
+    morton_codes.Sort();
+    morton_codes.SetNum( Algo::Unique( morton_codes ) );
+}
+
+void FSVOVolumeNavigationData::BuildOctree( const FReusableLeafNodes & reusable_leaf_nodes )
+{
+    const auto layer_count = SVOData->GetLayerCount();
+
+    // No need to keep the geometry alive once the data is generated, or once the generation is cancelled
+    ON_SCOPE_EXIT
+    {
+        Settings.GeometrySnapshot.Reset();
+        Settings.GenerationState.Reset();
+    };
+
+    if ( IsGenerationCancelled() )
+    {
+        return;
+    }
+
+    PropagateBlockedNodes();
+
+    BeginGenerationPhase( ESVOGenerationPhase::LeafRasterization, SVOData->GetLayerBlockedNodes( 0 ).Num() * 8 );
+    RasterizeInitialLayer( reusable_leaf_nodes );
+
+    {
+        int32 node_count = 0;
+        for ( LayerIndex layer_index = 1; layer_index < layer_count; ++layer_index )
+        {
+            node_count += SVOData->GetLayerBlockedNodes( layer_index ).Num() * 8;
+        }
+        BeginGenerationPhase( ESVOGenerationPhase::Layers, node_count );
+    }
+
+    {
+        SCOPE_CYCLE_COUNTER( STAT_SVONavigation_Layers );
+
+        for ( LayerIndex layer_index = 1; layer_index < layer_count; ++layer_index )
+        {
+            if ( IsGenerationCancelled() )
+            {
+                return;
+            }
+
+            RasterizeLayer( layer_index );
+            AddGenerationProcessedNodes( SVOData->GetLayer( layer_index ).GetNodeCount() );
+        }
+    }
+
+    if ( Settings.GenerationState.IsValid() )
+    {
+        Settings.GenerationState->UpdatePeakAllocatedSize( SVOData->GetAllocatedSize() );
+    }
+
+    SVOData->ReleaseBlockedNodes();
+
+    // Always built before the neighbor links, which look up the nodes by morton code, and only kept if the settings ask for it, or if the neighbors are found at query time
+    {
+        QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildMortonCodeIndices );
+
+        for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
+        {
+            SVOData->GetLayer( layer_index ).BuildMortonCodeIndex();
+        }
+    }
+
+    if ( Settings.GenerationSettings.bStoreNeighborLinks )
+    {
+        int32 node_count = 0;
+        for ( LayerIndex layer_index = 0; layer_index < layer_count - 1; ++layer_index )
+        {
+            node_count += SVOData->GetLayer( layer_index ).GetNodeCount();
+        }
+        BeginGenerationPhase( ESVOGenerationPhase::NeighborLinks, node_count );
+
+        SCOPE_CYCLE_COUNTER( STAT_SVONavigation_NeighborLinks );
+
+        for ( LayerIndex layer_index = layer_count - 2; layer_index != static_cast< LayerIndex >( -1 ); --layer_index )
+        {
+            BuildNeighborLinks( layer_index );
+        }
+    }
+
+    if ( IsGenerationCancelled() )
+    {
+        return;
+    }
+
+    if ( !Settings.GenerationSettings.bBuildMortonCodeIndex && Settings.GenerationSettings.bStoreNeighborLinks )
+    {
+        for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
+        {
+            SVOData->GetLayer( layer_index ).ResetMortonCodeIndex();
+        }
+    }
+
+    SVOData->bIsValid = true;
+    BeginGenerationPhase( ESVOGenerationPhase::Done, 0 );
+    INC_DWORD_STAT( STAT_SVONavigation_GeneratedVolumes );
 }
 
 void FSVOVolumeNavigationData::Serialize( FArchive & archive, const ESVOVersion version )
 {
+    LLM_SCOPE_BYTAG( SVONavigation );
+
     // when writing, write a zero here for now.  will come back and fill it in later.
     auto svo_size_bytes = 0;
     const auto svo_size_position = archive.Tell();
@@ -447,10 +782,32 @@ void FSVOVolumeNavigationData::Serialize( FArchive & archive, const ESVOVersion
     }
 
     archive << VolumeBounds;
-    archive << SVOData;
+    if ( archive.IsLoading() )
+    {
+        SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+        ChangeOctreeId();
+    }
+
+    auto is_compressed = archive.IsSaving() && GetDefault< USVONavigationSettings >()->bCompressNavigationData;
+    archive << is_compressed;
+
+    if ( is_compressed )
+    {
+        SVOData->SerializeCompressed( archive );
+    }
+    else
+    {
+        SVOData->SerializeFlat( archive );
+    }
+
     archive << VolumeNavigationQueryFilter;
     archive << bInNavigationDataChunk;
 
+    if ( archive.IsLoading() && is_compressed && SVOData->IsValid() && SVOData->GetLayer( 0 ).HasNeighborLinks() )
+    {
+        BuildNeighborLinksAfterLoad();
+    }
+
     if ( archive.IsSaving() )
     {
         const auto current_position = archive.Tell();
@@ -463,15 +820,51 @@ void FSVOVolumeNavigationData::Serialize( FArchive & archive, const ESVOVersion
     }
 }
 
+void FSVOVolumeNavigationData::AddDynamicObstacle( const int32 obstacle_id, const FSVODynamicObstacle & obstacle )
+{
+    // The copies of this object which share the previous obstacles keep them unchanged
+    auto dynamic_obstacles = MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >( *DynamicObstacles );
+    dynamic_obstacles->Add( obstacle_id, obstacle, *SVOData );
+    DynamicObstacles = dynamic_obstacles;
+}
+
+bool FSVOVolumeNavigationData::RemoveDynamicObstacle( const int32 obstacle_id )
+{
+    if ( !DynamicObstacles->Contains( obstacle_id ) )
+    {
+        return false;
+    }
+
+    auto dynamic_obstacles = MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >( *DynamicObstacles );
+    dynamic_obstacles->Remove( obstacle_id );
+    DynamicObstacles = dynamic_obstacles;
+    return true;
+}
+
 void FSVOVolumeNavigationData::Reset()
 {
     VolumeBounds.Init();
-    SVOData.Reset();
+    SVOData = MakeShared< FSVOData, ESPMode::ThreadSafe >();
+    ChangeOctreeId();
+    DynamicObstacles = MakeShared< FSVODynamicObstacles, ESPMode::ThreadSafe >();
+}
+
+void FSVOVolumeNavigationData::ChangeOctreeId()
+{
+    OctreeId = NextOctreeId.fetch_add( 1, std::memory_order_relaxed );
 }
 
 bool FSVOVolumeNavigationData::IsPositionOccluded( const FVector & position, const float box_extent ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_IsPositionOccluded );
+
+    AddGenerationOverlapQuery();
+
+    if ( Settings.GeometrySnapshot.IsValid() )
+    {
+        return Settings.GeometrySnapshot->IsBoxOccluded( FBox::BuildAABB( position, FVector( box_extent + Settings.GenerationSettings.Clearance ) ) );
+    }
+
     TArray< FOverlapResult > overlap_results;
     const auto result = Settings.World->OverlapMultiByChannel(  
         overlap_results,
@@ -493,159 +886,378 @@ bool FSVOVolumeNavigationData::IsPositionOccluded( const FVector & position, con
 
 void FSVOVolumeNavigationData::FirstPassRasterization()
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FirstPassRasterization );
+    SCOPE_CYCLE_COUNTER( STAT_SVONavigation_FirstPassRasterization );
     {
-        const auto & layer = SVOData.GetLayer( 1 );
-        const auto layer_max_node_count = layer.GetMaxNodeCount();
-        const auto layer_node_extent = layer.GetNodeExtent();        
+        // Instead of testing all the nodes of the layer 1, start from the root node and only test the children of the nodes which overlap geometry.
+        // The box of a child is inside the box of its parent, so a child can only be occluded if its parent is: we find the same blocked nodes,
+        // but the number of overlap queries depends on the surface of the obstacles and not on the size of the volume.
+        const auto parallel_for_flags = Settings.GenerationSettings.bUseParallelRasterization
+                                            ? EParallelForFlags::None
+                                            : EParallelForFlags::ForceSingleThread;
+
+        const LayerIndex top_layer_index = GetLayerCount() - 1;
+        const auto & top_layer = SVOData->GetLayer( top_layer_index );
+
+        BeginGenerationPhase( ESVOGenerationPhase::FirstPass, 1 );
+
+        TArray< MortonCode > occluded_morton_codes;
+
+        if ( IsPositionOccluded( GetNodePositionFromLayerAndMortonCode( top_layer_index, 0 ), top_layer.GetNodeExtent() ) )
+        {
+            occluded_morton_codes.Add( 0 );
+        }
+
+        TArray< bool > are_children_occluded;
+        TArray< MortonCode > occluded_children_morton_codes;
 
-        for ( MortonCode node_index = 0; node_index < layer_max_node_count; ++node_index )
+        AddGenerationProcessedNodes( 1 );
+
+        for ( LayerIndex layer_index = top_layer_index - 1; layer_index > 0 && occluded_morton_codes.Num() > 0 && !IsGenerationCancelled(); --layer_index )
         {
-            const auto position = GetNodePositionFromLayerAndMortonCode( 1, node_index );
-            
-            if ( IsPositionOccluded( position, layer_node_extent ) )
+            const auto layer_node_extent = SVOData->GetLayer( layer_index ).GetNodeExtent();
+            AddGenerationNodesToProcess( occluded_morton_codes.Num() * 8 );
+
+            are_children_occluded.Reset();
+            are_children_occluded.SetNumZeroed( occluded_morton_codes.Num() * 8 );
+
+            ParallelFor(
+                occluded_morton_codes.Num(),
+                [ & ]( const int32 parent_index ) {
+                    if ( IsGenerationCancelled() )
+                    {
+                        return;
+                    }
+
+                    const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( occluded_morton_codes[ parent_index ] );
+
+                    for ( auto child_index = 0; child_index < 8; ++child_index )
+                    {
+                        const auto position = GetNodePositionFromLayerAndMortonCode( layer_index, first_child_morton_code + child_index );
+                        are_children_occluded[ parent_index * 8 + child_index ] = IsPositionOccluded( position, layer_node_extent );
+                    }
+
+                    AddGenerationProcessedNodes( 8 );
+                },
+                parallel_for_flags );
+
+            // The parents are sorted, so the occluded children are found in increasing morton code order too
+            occluded_children_morton_codes.Reset();
+
+            for ( auto index = 0; index < are_children_occluded.Num(); ++index )
             {
-                SVOData.AddBlockedNode( 0, node_index );
+                if ( are_children_occluded[ index ] )
+                {
+                    occluded_children_morton_codes.Add( FSVOHelpers::GetFirstChildMortonCode( occluded_morton_codes[ index / 8 ] ) + index % 8 );
+                }
             }
+
+            Swap( occluded_morton_codes, occluded_children_morton_codes );
+        }
+
+        for ( const auto morton_code : occluded_morton_codes )
+        {
+            SVOData->AddBlockedNode( 0, morton_code );
         }
     }
+}
+
+void FSVOVolumeNavigationData::PropagateBlockedNodes()
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_PropagateBlockedNodes );
 
+    // The blocked nodes of the layer 1 are sorted, so the parent codes are sorted too.
+    // We only need to skip the consecutive duplicates to keep each array of blocked nodes sorted and unique.
+    for ( int32 layer_index = 1; layer_index < GetLayerCount(); layer_index++ )
     {
-        for ( int32 layer_index = 1; layer_index < GetLayerCount(); layer_index++ )
+        const auto & parent_layer_blocked_nodes = SVOData->GetLayerBlockedNodes( layer_index - 1 );
+        const auto & layer_blocked_nodes = SVOData->GetLayerBlockedNodes( layer_index );
+
+        for ( const MortonCode morton_code : parent_layer_blocked_nodes )
         {
-            const auto & parent_layer_blocked_nodes = SVOData.GetLayerBlockedNodes( layer_index - 1 );
-            for ( const MortonCode morton_code : parent_layer_blocked_nodes )
+            const auto parent_morton_code = FSVOHelpers::GetParentMortonCode( morton_code );
+
+            if ( layer_blocked_nodes.Num() == 0 || layer_blocked_nodes.Last() != parent_morton_code )
             {
-                SVOData.AddBlockedNode( layer_index, FSVOHelpers::GetParentMortonCode( morton_code ) );
+                SVOData->AddBlockedNode( layer_index, parent_morton_code );
             }
         }
     }
 }
 
-void FSVOVolumeNavigationData::RasterizeLeaf( const FVector & node_position, const LeafIndex leaf_index )
+uint_fast64_t FSVOVolumeNavigationData::RasterizeLeaf( const FVector & node_position ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLeaf );
 
-    const auto leaf_node_extent = SVOData.GetLeafNodes().GetLeafNodeExtent();
-    const auto leaf_sub_node_size = SVOData.GetLeafNodes().GetLeafSubNodeSize();
-    const auto leaf_sub_node_extent = SVOData.GetLeafNodes().GetLeafSubNodeExtent();
+    // The geometry which overlaps the leaf is gathered once, and the sub nodes are only tested against it.
+    // The sub nodes tile the leaf node, so the returned mask is empty if and only if the leaf node is not occluded
+    return Settings.GeometrySnapshot.IsValid()
+               ? RasterizeLeafWithGeometrySnapshot( node_position )
+               : RasterizeLeafWithPhysicsScene( node_position );
+}
+
+uint_fast64_t FSVOVolumeNavigationData::RasterizeLeafWithGeometrySnapshot( const FVector & node_position ) const
+{
+    const auto & geometry_snapshot = *Settings.GeometrySnapshot;
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
+    const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
+    const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+    const auto leaf_sub_node_extent = leaf_nodes.GetLeafSubNodeExtent();
+    const auto clearance = Settings.GenerationSettings.Clearance;
     const auto location = node_position - leaf_node_extent;
 
-    for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; sub_node_index++ )
+    TArray< int32, TInlineAllocator< 64 > > primitive_indices;
+    AddGenerationOverlapQuery();
+    geometry_snapshot.GatherPrimitives( primitive_indices, FBox::BuildAABB( node_position, FVector( leaf_node_extent + clearance ) ) );
+
+    FSVOLeafNode leaf_node;
+
+    for ( const auto primitive_index : primitive_indices )
     {
-        const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( sub_node_index );
-        const auto leaf_node_location = location + morton_coords * leaf_sub_node_size + leaf_sub_node_extent;
-        const bool is_leaf_occluded = IsPositionOccluded( leaf_node_location, leaf_sub_node_extent );
+        // Only test the sub nodes whose box can intersect the bounds of the primitive, and which are not already occluded
+        const auto & primitive_bounds = geometry_snapshot.GetPrimitiveBounds( primitive_index );
+        const auto min_coords = ( primitive_bounds.Min - location - clearance ) / leaf_sub_node_size;
+        const auto max_coords = ( primitive_bounds.Max - location + clearance ) / leaf_sub_node_size;
+        const FIntVector min_sub_node_coords( FMath::Clamp( FMath::FloorToInt( min_coords.X ), 0, 3 ), FMath::Clamp( FMath::FloorToInt( min_coords.Y ), 0, 3 ), FMath::Clamp( FMath::FloorToInt( min_coords.Z ), 0, 3 ) );
+        const FIntVector max_sub_node_coords( FMath::Clamp( FMath::FloorToInt( max_coords.X ), 0, 3 ), FMath::Clamp( FMath::FloorToInt( max_coords.Y ), 0, 3 ), FMath::Clamp( FMath::FloorToInt( max_coords.Z ), 0, 3 ) );
+
+        for ( auto z = min_sub_node_coords.Z; z <= max_sub_node_coords.Z; ++z )
+        {
+            for ( auto y = min_sub_node_coords.Y; y <= max_sub_node_coords.Y; ++y )
+            {
+                for ( auto x = min_sub_node_coords.X; x <= max_sub_node_coords.X; ++x )
+                {
+                    const SubNodeIndex sub_node_index = morton3D_64_encode( x, y, z );
 
-        SVOData.GetLeafNodes().AddLeafNode( leaf_index, sub_node_index, is_leaf_occluded );
-    }
-}
+                    if ( leaf_node.IsSubNodeOccluded( sub_node_index ) )
+                    {
+                        continue;
+                    }
 
-void FSVOVolumeNavigationData::RasterizeInitialLayer( TMap< LeafIndex, MortonCode > & leaf_index_to_layer_one_node_index_map )
-{
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeInitialLayer );
+                    const auto sub_node_location = location + FVector( x, y, z ) * leaf_sub_node_size + leaf_sub_node_extent;
 
-    auto & layer_zero = SVOData.GetLayer( 0 );
-    auto & layer_zero_nodes = layer_zero.GetNodes();
+                    if ( geometry_snapshot.IsBoxOccludedByPrimitive( FBox::BuildAABB( sub_node_location, FVector( leaf_sub_node_extent + clearance ) ), primitive_index ) )
+                    {
+                        leaf_node.MarkSubNodeAsOccluded( sub_node_index );
+                    }
+                }
+            }
+        }
 
-    LeafIndex leaf_index = 0;
-    const auto & layer_zero_blocked_nodes = SVOData.GetLayerBlockedNodes( 0 );
-    const auto layer_one_blocked_node_count = layer_zero_blocked_nodes.Num();
-    layer_zero_nodes.Reserve( layer_one_blocked_node_count * 8 );
+        if ( leaf_node.IsCompletelyOccluded() )
+        {
+            break;
+        }
+    }
 
-    const auto layer_max_node_count = layer_zero.GetMaxNodeCount();
+    return leaf_node.SubNodes;
+}
 
-    auto & leaf_nodes = SVOData.GetLeafNodes();
+uint_fast64_t FSVOVolumeNavigationData::RasterizeLeafWithPhysicsScene( const FVector & node_position ) const
+{
+    const auto & leaf_nodes = SVOData->GetLeafNodes();
     const auto leaf_node_extent = leaf_nodes.GetLeafNodeExtent();
+    const auto leaf_sub_node_size = leaf_nodes.GetLeafSubNodeSize();
+    const auto leaf_sub_node_extent = leaf_nodes.GetLeafSubNodeExtent();
+    const auto & generation_settings = Settings.GenerationSettings;
+    const auto location = node_position - leaf_node_extent;
+
+    TArray< FOverlapResult > overlap_results;
+    AddGenerationOverlapQuery();
+    Settings.World->OverlapMultiByChannel(
+        overlap_results,
+        node_position,
+        FQuat::Identity,
+        generation_settings.CollisionChannel,
+        FCollisionShape::MakeBox( FVector( leaf_node_extent + generation_settings.Clearance ) ),
+        generation_settings.CollisionQueryParameters );
+
+    TArray< const FBodyInstance *, TInlineAllocator< 16 > > body_instances;
+    auto must_query_physics_scene = false;
 
-    for ( NodeIndex node_index = 0; node_index < layer_max_node_count; node_index++ )
+    for ( const auto & overlap_result : overlap_results )
     {
-        const auto parent_morton_code = FSVOHelpers::GetParentMortonCode( node_index );
-        const auto is_blocked = layer_zero_blocked_nodes.Contains( parent_morton_code );
+        const auto * component = overlap_result.GetComponent();
 
-        if ( !is_blocked )
+        if ( component == nullptr || !component->CanEverAffectNavigation() )
         {
             continue;
         }
 
-        auto & layer_zero_node = layer_zero_nodes.Emplace_GetRef();
-        layer_zero_node.MortonCode = node_index;
-
-        const auto leaf_node_position = GetLeafNodePositionFromMortonCode( layer_zero_node.MortonCode );
-
-        leaf_index_to_layer_one_node_index_map.Add( leaf_index, parent_morton_code );
+        // Instanced static meshes have one body instance per instance. Other components with several bodies, like skeletal meshes, are tested against the physics scene
+        const auto * body_instance = overlap_result.ItemIndex == INDEX_NONE || component->IsA< UInstancedStaticMeshComponent >()
+                                         ? component->GetBodyInstance( NAME_None, true, overlap_result.ItemIndex )
+                                         : nullptr;
 
-        if ( IsPositionOccluded( leaf_node_position, leaf_node_extent ) )
+        if ( body_instance != nullptr )
         {
-            RasterizeLeaf( leaf_node_position, leaf_index );
-            layer_zero_node.FirstChild.LayerIndex = 0;
-            layer_zero_node.FirstChild.NodeIndex = leaf_index;
-            layer_zero_node.FirstChild.SubNodeIndex = 0;
+            body_instances.AddUnique( body_instance );
         }
         else
         {
-            leaf_nodes.AddEmptyLeafNode();
-            layer_zero_node.FirstChild.Invalidate();
+            must_query_physics_scene = true;
         }
+    }
+
+    FSVOLeafNode leaf_node;
 
-        leaf_index++;
+    if ( body_instances.Num() == 0 && !must_query_physics_scene )
+    {
+        return leaf_node.SubNodes;
     }
+
+    const auto sub_node_collision_shape = FCollisionShape::MakeBox( FVector( leaf_sub_node_extent + generation_settings.Clearance ) );
+
+    for ( SubNodeIndex sub_node_index = 0; sub_node_index < 64; sub_node_index++ )
+    {
+        const auto morton_coords = FSVOHelpers::GetVectorFromMortonCode( sub_node_index );
+        const auto sub_node_location = location + morton_coords * leaf_sub_node_size + leaf_sub_node_extent;
+
+        const auto is_occluded = must_query_physics_scene
+                                     ? IsPositionOccluded( sub_node_location, leaf_sub_node_extent )
+                                     : body_instances.ContainsByPredicate( [ & ]( const FBodyInstance * body_instance ) {
+                                           return body_instance->OverlapTest( sub_node_location, FQuat::Identity, sub_node_collision_shape, nullptr, generation_settings.CollisionQueryParameters.bTraceComplex );
+                                       } );
+
+        if ( is_occluded )
+        {
+            leaf_node.MarkSubNodeAsOccluded( sub_node_index );
+        }
+    }
+
+    return leaf_node.SubNodes;
 }
 
-void FSVOVolumeNavigationData::RasterizeLayer( const LayerIndex layer_index )
+void FSVOVolumeNavigationData::RasterizeInitialLayer( const FReusableLeafNodes & reusable_leaf_nodes )
 {
-    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLayer );
-
-    auto & layer = SVOData.GetLayer( layer_index );
-    auto & layer_nodes = layer.GetNodes();
-    const auto & layer_blocked_nodes = SVOData.GetLayerBlockedNodes( layer_index );
+    SCOPE_CYCLE_COUNTER( STAT_SVONavigation_LeafRasterization );
 
-    checkf( layer_index > 0 && layer_index < GetLayerCount(), TEXT( "layer_index is out of bounds" ) );
+    auto & layer_zero = SVOData->GetLayer( 0 );
 
-    layer_nodes.Reserve( layer_blocked_nodes.Num() * 8 );
+    const auto & layer_zero_blocked_nodes = SVOData->GetLayerBlockedNodes( 0 );
+    const auto layer_one_blocked_node_count = layer_zero_blocked_nodes.Num();
+    layer_zero.ReserveNodes( layer_one_blocked_node_count * 8 );
 
-    const auto layer_max_node_count = layer.GetMaxNodeCount();
+    // The leaves are rasterized in this array first, since the tasks can't write the sparse leaves concurrently
+    TArray< uint_fast64_t > leaves_sub_nodes;
+    leaves_sub_nodes.SetNumZeroed( layer_one_blocked_node_count * 8 );
 
-    for ( NodeIndex node_index = 0; node_index < layer_max_node_count; node_index++ )
+    // Create all the nodes first. The blocked nodes are sorted, so the children are created in increasing morton code order.
+    // The leaf indices only depend on the morton codes, so the result is the same whether the leaves are rasterized serially or in parallel
+    for ( const MortonCode parent_morton_code : layer_zero_blocked_nodes )
     {
-        const auto is_blocked = layer_blocked_nodes.Contains( FSVOHelpers::GetParentMortonCode( node_index ) );
+        const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( parent_morton_code );
 
-        if ( !is_blocked )
+        for ( auto child_index = 0; child_index < 8; ++child_index )
         {
-            continue;
+            layer_zero.AddNode( first_child_morton_code + child_index );
         }
+    }
+
+    // The 8 children of a blocked layer 1 node are contiguous. Each task rasterizes all the leaves of one of those nodes, and only writes to them.
+    const auto parallel_for_flags = Settings.GenerationSettings.bUseParallelRasterization
+                                        ? EParallelForFlags::None
+                                        : EParallelForFlags::ForceSingleThread;
+
+    ParallelFor(
+        layer_one_blocked_node_count,
+        [ & ]( const int32 layer_one_node_index ) {
+            if ( IsGenerationCancelled() )
+            {
+                return;
+            }
+
+            const auto reusable_index = Algo::BinarySearch( reusable_leaf_nodes.LayerOneMortonCodes, static_cast< MortonCode >( layer_zero_blocked_nodes[ layer_one_node_index ] ) );
+
+            for ( auto child_index = 0; child_index < 8; ++child_index )
+            {
+                const LeafIndex child_leaf_index = layer_one_node_index * 8 + child_index;
+                auto & first_child = layer_zero.GetNodeFirstChild( child_leaf_index );
+                const auto sub_nodes = reusable_index != INDEX_NONE
+                                           ? reusable_leaf_nodes.SubNodes[ reusable_index * 8 + child_index ]
+                                           : RasterizeLeaf( GetLeafNodePositionFromMortonCode( layer_zero.GetNodeMortonCode( child_leaf_index ) ) );
+
+                if ( sub_nodes != 0 )
+                {
+                    leaves_sub_nodes[ child_leaf_index ] = sub_nodes;
+                    first_child.LayerIndex = 0;
+                    first_child.NodeIndex = child_leaf_index;
+                    first_child.SubNodeIndex = 0;
+                }
+                else
+                {
+                    first_child.Invalidate();
+                }
+            }
 
-        const auto new_node_index = layer_nodes.Emplace();
+            AddGenerationProcessedNodes( 8 );
+        },
+        parallel_for_flags );
 
-        auto & layer_node = layer_nodes[ new_node_index ];
-        layer_node.MortonCode = node_index;
+    {
+        QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildLeafNodes );
+        SVOData->GetLeafNodes().Build( leaves_sub_nodes );
+    }
+}
+
+void FSVOVolumeNavigationData::RasterizeLayer( const LayerIndex layer_index )
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_RasterizeLayer );
 
-        const auto child_layer_index = layer_index - 1;
-        const auto first_child_morton_code = FSVOHelpers::GetFirstChildMortonCode( layer_node.MortonCode );
-        const auto child_index_from_code = GetNodeIndexFromMortonCode( child_layer_index, first_child_morton_code );
+    checkf( layer_index > 0 && layer_index < GetLayerCount(), TEXT( "layer_index is out of bounds" ) );
+
+    auto & layer = SVOData->GetLayer( layer_index );
+    const auto layer_max_node_count = layer.GetMaxNodeCount();
+    const auto & layer_blocked_nodes = SVOData->GetLayerBlockedNodes( layer_index );
+
+    const auto child_layer_index = layer_index - 1;
+    auto & child_layer = SVOData->GetLayer( child_layer_index );
+    // The nodes of this layer which have children. The child layer contains the 8 children of each of those nodes, in the same order
+    const auto & child_layer_blocked_nodes = SVOData->GetLayerBlockedNodes( child_layer_index );
 
-        auto & first_child = layer_node.FirstChild;
+    layer.ReserveNodes( layer_blocked_nodes.Num() * 8 );
+
+    // Both arrays of blocked nodes are sorted, so we can find the nodes which have children by walking them side by side
+    int32 child_layer_blocked_node_index = 0;
+
+    for ( const MortonCode parent_morton_code : layer_blocked_nodes )
+    {
+        const auto first_morton_code = FSVOHelpers::GetFirstChildMortonCode( parent_morton_code );
 
-        if ( child_index_from_code != INDEX_NONE )
+        for ( auto sibling_index = 0; sibling_index < 8; ++sibling_index )
         {
-            // Set parent->child links
-            first_child.LayerIndex = child_layer_index;
-            first_child.NodeIndex = child_index_from_code;
+            const auto morton_code = first_morton_code + sibling_index;
 
-            auto & child_layer = SVOData.GetLayer( child_layer_index );
+            // The top layer only has one node
+            if ( morton_code >= layer_max_node_count )
+            {
+                break;
+            }
 
-            // Set child->parent links
-            for ( auto child_index = 0; child_index < 8; ++child_index )
+            const auto new_node_index = layer.AddNode( morton_code );
+            auto & first_child = layer.GetNodeFirstChild( new_node_index );
+
+            if ( child_layer_blocked_node_index < child_layer_blocked_nodes.Num() && child_layer_blocked_nodes[ child_layer_blocked_node_index ] == morton_code )
             {
-                auto & child_node = child_layer.GetNodes()[ first_child.NodeIndex + child_index ];
+                // Set parent->child links
+                first_child.LayerIndex = child_layer_index;
+                first_child.NodeIndex = child_layer_blocked_node_index * 8;
+
+                // Set child->parent links
+                for ( auto child_index = 0; child_index < 8; ++child_index )
+                {
+                    const auto child_node_index = first_child.NodeIndex + child_index;
+                    auto & child_node_parent = child_layer.GetNodeParent( child_node_index );
 
-                child_node.Parent.LayerIndex = layer_index;
-                child_node.Parent.NodeIndex = new_node_index;
+                    child_node_parent.LayerIndex = layer_index;
+                    child_node_parent.NodeIndex = new_node_index;
+                }
+
+                child_layer_blocked_node_index++;
+            }
+            else
+            {
+                first_child.Invalidate();
             }
-        }
-        else
-        {
-            first_child.Invalidate();
         }
     }
 }
@@ -654,59 +1266,117 @@ int32 FSVOVolumeNavigationData::GetNodeIndexFromMortonCode( const LayerIndex lay
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetNodeIndexFromMortonCode );
 
-    const auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
-
-    // Since nodes are ordered, we can use the binary search
-    return Algo::BinarySearch( layer_nodes, FSVONode( morton_code ) );
+    return SVOData->GetLayer( layer_index ).GetNodeIndexFromMortonCode( morton_code );
 }
 
 void FSVOVolumeNavigationData::BuildNeighborLinks( const LayerIndex layer_index )
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildNeighborLinks );
 
-    auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
-    const auto max_layer_index = GetLayerCount() - 2;
+    auto & layer = SVOData->GetLayer( layer_index );
 
-    for ( NodeIndex layer_node_index = 0; layer_node_index < static_cast< uint32 >( layer_nodes.Num() ); layer_node_index++ )
-    {
-        auto & node = layer_nodes[ layer_node_index ];
+    const auto parallel_for_flags = Settings.GenerationSettings.bUseParallelRasterization
+                                        ? EParallelForFlags::None
+                                        : EParallelForFlags::ForceSingleThread;
 
-        for ( NeighborDirection direction = 0; direction < 6; direction++ )
-        {
-            NodeIndex node_index = layer_node_index;
-            FSVONodeAddress & neighbor_address = node.Neighbors[ direction ];
-            LayerIndex current_layer = layer_index;
+    // Each task only writes the neighbor links of its node, and the lookups never read the neighbor links of the other nodes
+    ParallelFor(
+        layer.GetNodeCount(),
+        [ & ]( const int32 layer_node_index ) {
+            if ( IsGenerationCancelled() )
+            {
+                return;
+            }
 
-            while ( !FindNeighborInDirection( neighbor_address, current_layer, node_index, direction ) && current_layer < max_layer_index )
+            for ( NeighborDirection direction = 0; direction < 6; direction++ )
             {
-                auto & parent_address = SVOData.GetLayer( current_layer ).GetNodes()[ node_index ].Parent;
-                if ( parent_address.IsValid() )
-                {
-                    node_index = parent_address.NodeIndex;
-                    current_layer = parent_address.LayerIndex;
-                }
-                else
-                {
-                    current_layer++;
-                    const auto node_index_from_morton = GetNodeIndexFromMortonCode( current_layer, FSVOHelpers::GetParentMortonCode( node.MortonCode ) );
-                    check( node_index_from_morton != INDEX_NONE );
-                    node_index = static_cast< NodeIndex >( node_index_from_morton );
-                }
+                layer.GetNodeNeighbor( layer_node_index, direction ) = FindNeighbor( layer_index, layer_node_index, direction );
             }
+
+            AddGenerationProcessedNodes( 1 );
+        },
+        parallel_for_flags );
+}
+
+void FSVOVolumeNavigationData::BuildNeighborLinksAfterLoad()
+{
+    QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_BuildNeighborLinksAfterLoad );
+
+    const auto layer_count = GetLayerCount();
+
+    // The neighbors are found with the morton code indices, which were only saved when the settings kept them
+    TArray< LayerIndex, TInlineAllocator< 16 > > layers_with_temporary_index;
+
+    for ( LayerIndex layer_index = 0; layer_index < layer_count; ++layer_index )
+    {
+        auto & layer = SVOData->GetLayer( layer_index );
+
+        if ( !layer.HasMortonCodeIndex() )
+        {
+            layer.BuildMortonCodeIndex();
+            layers_with_temporary_index.Add( layer_index );
+        }
+    }
+
+    for ( LayerIndex layer_index = layer_count - 2; layer_index != static_cast< LayerIndex >( -1 ); --layer_index )
+    {
+        BuildNeighborLinks( layer_index );
+    }
+
+    for ( const auto layer_index : layers_with_temporary_index )
+    {
+        SVOData->GetLayer( layer_index ).ResetMortonCodeIndex();
+    }
+}
+
+FSVONodeAddress FSVOVolumeNavigationData::GetNodeNeighbor( const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction ) const
+{
+    const auto & layer = SVOData->GetLayer( layer_index );
+
+    return layer.HasNeighborLinks()
+               ? layer.GetNodeNeighbor( node_index, direction )
+               : FindNeighbor( layer_index, node_index, direction );
+}
+
+FSVONodeAddress FSVOVolumeNavigationData::FindNeighbor( const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction ) const
+{
+    const auto max_layer_index = GetLayerCount() - 2;
+
+    FSVONodeAddress neighbor_address;
+    NodeIndex current_node_index = node_index;
+    LayerIndex current_layer = layer_index;
+
+    while ( !FindNeighborInDirection( neighbor_address, current_layer, current_node_index, direction ) && current_layer < max_layer_index )
+    {
+        const auto & parent_address = SVOData->GetLayer( current_layer ).GetNodeParent( current_node_index );
+        if ( parent_address.IsValid() )
+        {
+            current_node_index = parent_address.NodeIndex;
+            current_layer = parent_address.LayerIndex;
+        }
+        else
+        {
+            current_layer++;
+            const auto node_index_from_morton = GetNodeIndexFromMortonCode( current_layer, FSVOHelpers::GetParentMortonCode( SVOData->GetLayer( layer_index ).GetNodeMortonCode( node_index ) ) );
+            check( node_index_from_morton != INDEX_NONE );
+            current_node_index = static_cast< NodeIndex >( node_index_from_morton );
         }
     }
+
+    return neighbor_address;
 }
 
-bool FSVOVolumeNavigationData::FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction )
+bool FSVOVolumeNavigationData::FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction ) const
 {
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_FindNeighborInDirection );
 
-    const auto max_coordinates = static_cast< int32 >( SVOData.GetLayer( layer_index ).GetMaxNodeCount() );
-    const auto & layer_nodes = SVOData.GetLayer( layer_index ).GetNodes();
-    const auto layer_nodes_count = layer_nodes.Num();
-    const auto & target_node = layer_nodes[ node_index ];
+    const auto & layer = SVOData->GetLayer( layer_index );
+    const auto max_coordinates = static_cast< int64 >( layer.GetMaxNodeCount() );
+    const auto & layer_morton_codes = layer.GetMortonCodes();
+    const auto layer_nodes_count = layer_morton_codes.Num();
+    const auto target_morton_code = layer_morton_codes[ node_index ];
 
-    FIntVector neighbor_coords( FSVOHelpers::GetVectorFromMortonCode( target_node.MortonCode ) );
+    FIntVector neighbor_coords( FSVOHelpers::GetVectorFromMortonCode( target_morton_code ) );
     neighbor_coords += NeighborDirections[ direction ];
 
     if ( neighbor_coords.X < 0 || neighbor_coords.X >= max_coordinates ||
@@ -719,48 +1389,60 @@ bool FSVOVolumeNavigationData::FindNeighborInDirection( FSVONodeAddress & node_a
 
     const auto neighbor_code = FSVOHelpers::GetMortonCodeFromVector( neighbor_coords );
 
-    int32 stop_index = layer_nodes_count;
-    int32 increment = 1;
+    int32 neighbor_node_index = INDEX_NONE;
 
-    if ( neighbor_code < target_node.MortonCode )
+    if ( layer.HasMortonCodeIndex() )
     {
-        increment = -1;
-        stop_index = -1;
+        neighbor_node_index = layer.GetNodeIndexFromMortonCode( neighbor_code );
     }
-
-    for ( int32 neighbor_node_index = node_index + increment; neighbor_node_index != stop_index; neighbor_node_index += increment )
+    else
     {
-        auto & node = layer_nodes[ neighbor_node_index ];
+        int32 stop_index = layer_nodes_count;
+        int32 increment = 1;
 
-        if ( node.MortonCode == neighbor_code )
+        if ( neighbor_code < target_morton_code )
         {
-            if ( layer_index == 0 &&
-                 node.HasChildren() &&
-                 SVOData.GetLeafNodes().GetLeafNode( node.FirstChild.NodeIndex ).IsCompletelyOccluded() )
+            increment = -1;
+            stop_index = -1;
+        }
+
+        for ( int32 candidate_node_index = node_index + increment; candidate_node_index != stop_index; candidate_node_index += increment )
+        {
+            const auto candidate_morton_code = layer_morton_codes[ candidate_node_index ];
+
+            if ( candidate_morton_code == neighbor_code )
             {
-                node_address.Invalidate();
-                return true;
+                neighbor_node_index = candidate_node_index;
+                break;
             }
 
-            node_address.LayerIndex = layer_index;
-
-            if ( neighbor_node_index >= layer_nodes_count || neighbor_node_index < 0 )
+            // If we've passed the code we're looking for, it's not on this layer
+            if ( increment == -1 && candidate_morton_code < neighbor_code || increment == 1 && candidate_morton_code > neighbor_code )
             {
                 break;
             }
+        }
+    }
 
-            node_address.NodeIndex = neighbor_node_index;
+    if ( neighbor_node_index == INDEX_NONE )
+    {
+        return false;
+    }
 
-            return true;
-        }
+    const auto & neighbor_first_child = layer.GetNodeFirstChild( neighbor_node_index );
 
-        // If we've passed the code we're looking for, it's not on this layer
-        if ( increment == -1 && node.MortonCode < neighbor_code || increment == 1 && node.MortonCode > neighbor_code )
-        {
-            return false;
-        }
+    if ( layer_index == 0 &&
+         neighbor_first_child.IsValid() &&
+         SVOData->GetLeafNodes().GetLeafNode( neighbor_first_child.NodeIndex ).IsCompletelyOccluded() )
+    {
+        node_address.Invalidate();
+        return true;
     }
-    return false;
+
+    node_address.LayerIndex = layer_index;
+    node_address.NodeIndex = neighbor_node_index;
+
+    return true;
 }
 
 void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address ) const
@@ -768,8 +1450,8 @@ void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & nei
     QUICK_SCOPE_CYCLE_COUNTER( STAT_SVOBoundsNavigationData_GetLeafNeighbors );
 
     const MortonCode leaf_index = leaf_address.SubNodeIndex;
-    const FSVONode & node = GetNodeFromAddress( leaf_address );
-    const FSVOLeafNode & leaf = SVOData.GetLeafNodes().GetLeafNode( node.FirstChild.NodeIndex );
+    const auto & layer_zero = SVOData->GetLayer( 0 );
+    const FSVOLeafNode & leaf = SVOData->GetLeafNodes().GetLeafNode( layer_zero.GetNodeFirstChild( leaf_address.NodeIndex ).NodeIndex );
 
     uint_fast32_t x = 0, y = 0, z = 0;
     morton3D_64_decode( leaf_index, x, y, z );
@@ -791,17 +1473,24 @@ void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & nei
         }
         else // the neighbor is out of bounds, we need to find our neighbor
         {
-            const FSVONodeAddress & neighbor_address = node.Neighbors[ neighbor_direction ];
-            const FSVONode & neighbor_node = GetNodeFromAddress( neighbor_address );
+            const auto neighbor_address = GetNodeNeighbor( 0, leaf_address.NodeIndex, neighbor_direction );
+
+            // The leaf is on the border of the volume
+            if ( !neighbor_address.IsValid() )
+            {
+                continue;
+            }
+
+            const auto & neighbor_first_child = SVOData->GetLayer( neighbor_address.LayerIndex ).GetNodeFirstChild( neighbor_address.NodeIndex );
 
             // If the neighbor layer 0 has no leaf nodes, just return it
-            if ( !neighbor_node.FirstChild.IsValid() )
+            if ( !neighbor_first_child.IsValid() )
             {
                 neighbors.Add( neighbor_address );
                 continue;
             }
 
-            const FSVOLeafNode & leaf_node = SVOData.GetLeafNodes().GetLeafNode( neighbor_node.FirstChild.NodeIndex );
+            const FSVOLeafNode & leaf_node = SVOData->GetLeafNodes().GetLeafNode( neighbor_first_child.NodeIndex );
 
             // leaf not occluded. Find the correct subnode
             if ( !leaf_node.IsCompletelyOccluded() )
@@ -836,7 +1525,7 @@ void FSVOVolumeNavigationData::GetLeafNeighbors( TArray< FSVONodeAddress > & nei
                 // Only return the neighbor if it isn't blocked!
                 if ( !leaf_node.IsSubNodeOccluded( sub_node_index ) )
                 {
-                    neighbors.Emplace( FSVONodeAddress( 0, neighbor_node.FirstChild.NodeIndex, sub_node_index ) );
+                    neighbors.Emplace( FSVONodeAddress( 0, neighbor_first_child.NodeIndex, sub_node_index ) );
                 }
             }
             // else the leaf node is completely blocked, we don't return it
@@ -851,7 +1540,7 @@ void FSVOVolumeNavigationData::GetFreeNodesFromNodeAddress( const FSVONodeAddres
 
     if ( layer_index == 0 )
     {
-        const auto & leaf_node = SVOData.LeafNodes.GetLeafNode( node_index );
+        const auto & leaf_node = SVOData->LeafNodes.GetLeafNode( node_index );
 
         if ( leaf_node.IsCompletelyOccluded() )
         {
@@ -874,37 +1563,21 @@ void FSVOVolumeNavigationData::GetFreeNodesFromNodeAddress( const FSVONodeAddres
     }
     else
     {
-        const auto & node = SVOData.GetLayer( layer_index ).GetNode( node_index );
+        const auto & first_child = SVOData->GetLayer( layer_index ).GetNodeFirstChild( node_index );
 
-        if ( !node.HasChildren() )
+        if ( !first_child.IsValid() )
         {
             free_nodes.Emplace( node_address );
         }
         else
         {
-            const auto & first_child = node.FirstChild;
             const auto child_layer_index = first_child.LayerIndex;
-            const auto & child_layer = SVOData.GetLayer( child_layer_index );
+            const auto & child_layer = SVOData->GetLayer( child_layer_index );
 
             for ( auto child_index = 0; child_index < 8; ++child_index )
             {
-                const auto & child_node = child_layer.GetNodes()[ first_child.NodeIndex + child_index ];
-                GetFreeNodesFromNodeAddress( FSVONodeAddress( child_layer_index, child_node.MortonCode, 0 ), free_nodes );
+                GetFreeNodesFromNodeAddress( FSVONodeAddress( child_layer_index, child_layer.GetNodeMortonCode( first_child.NodeIndex + child_index ), 0 ), free_nodes );
             }
         }
     }
 }
-
-void FSVOVolumeNavigationData::BuildParentLinkForLeafNodes( const TMap<LeafIndex, MortonCode> & leaf_index_to_parent_morton_code_map )
-{
-    for ( const auto & key_pair : leaf_index_to_parent_morton_code_map )
-    {
-        auto & leaf_node = SVOData.GetLeafNodes().GetLeafNode( key_pair.Key );
-        leaf_node.Parent.LayerIndex = 1;
-
-        const auto node_index = GetNodeIndexFromMortonCode( 1, key_pair.Value );
-        check( node_index != INDEX_NONE );
-
-        leaf_node.Parent.NodeIndex = node_index;
-    }
-}
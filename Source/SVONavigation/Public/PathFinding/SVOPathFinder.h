@@ -8,10 +8,12 @@ struct FSVOPathFinderDebugInfos;
 class FSVOPathFindingAlgorithmStepper;
 struct FPathFindingQuery;
 class ASVONavigationData;
+class FSVOVolumeNavigationData;
 
 class SVONAVIGATION_API FSVOPathFinder
 {
 public:
-    static ENavigationQueryResult::Type GetPath( FSVONavigationPath & navigation_path, const ASVONavigationData & navigation_data, const FVector & start_location, const FVector & end_location, FSharedConstNavQueryFilter nav_query_filter );
+    // volume_navigation_data must contain both locations. Pass a copy of the volume, so the search doesn't need to lock the navigation data
+    static ENavigationQueryResult::Type GetPath( FSVONavigationPath & navigation_path, const ASVONavigationData & navigation_data, const FSVOVolumeNavigationData & volume_navigation_data, const FVector & start_location, const FVector & end_location, FSharedConstNavQueryFilter nav_query_filter );
     static TSharedPtr< FSVOPathFindingAlgorithmStepper > GetDebugPathStepper( FSVOPathFinderDebugInfos & debug_infos, const ASVONavigationData & navigation_data, const FVector & start_location, const FVector & end_location, const FSharedConstNavQueryFilter & nav_query_filter );
 };
@@ -33,7 +33,8 @@ class FSVOPathFindingAlgorithmStepper
 {
 public:
     explicit FSVOPathFindingAlgorithmStepper( const FSVOPathFindingParameters & parameters );
-    virtual ~FSVOPathFindingAlgorithmStepper() = default;
+    // Reports the size of the node pool to the memory stats
+    virtual ~FSVOPathFindingAlgorithmStepper();
 
     ESVOPathFindingAlgorithmState GetState() const;
     const FSVOPathFindingParameters & GetParameters() const;
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SVONavigationTypes.h"
+
+#include <CoreMinimal.h>
+#include <Containers/StaticArray.h>
+
+enum class ESVODynamicObstacleShape : uint8
+{
+    Box,
+    Sphere
+};
+
+struct SVONAVIGATION_API FSVODynamicObstacle
+{
+    static FSVODynamicObstacle MakeBox( const FBox & box );
+    static FSVODynamicObstacle MakeSphere( const FVector & center, float radius );
+
+    bool IntersectsBox( const FBox & box ) const;
+    bool IntersectsSegment( const FVector & from, const FVector & to ) const;
+
+    FBox Bounds;
+    ESVODynamicObstacleShape Shape;
+    float SphereRadius;
+};
+
+/*
+ * Obstacles added at runtime on top of the generated navigation data, without generating it again.
+ * The free nodes which intersect an obstacle are blocked as a whole, and the leaf nodes get an override mask of their occluded sub nodes.
+ */
+class SVONAVIGATION_API FSVODynamicObstacles
+{
+public:
+    FSVODynamicObstacles();
+
+    void Add( int32 obstacle_id, const FSVODynamicObstacle & obstacle, const FSVOData & data );
+    bool Remove( int32 obstacle_id );
+    void Reset();
+    bool IsEmpty() const;
+    bool Contains( int32 obstacle_id ) const;
+
+    bool IsNodeBlocked( const FSVONodeAddress & node_address ) const;
+    bool DoesSegmentIntersectObstacle( const FVector & from, const FVector & to ) const;
+
+    int64 GetAllocatedSize() const;
+
+private:
+    struct FObstacleEntry
+    {
+        FSVODynamicObstacle Obstacle;
+        TArray< FSVONodeAddress > BlockedNodes;
+        TMap< LeafIndex, uint64 > LeafSubNodes;
+    };
+
+    void RasterizeObstacle( FObstacleEntry & entry, const FSVOData & data );
+    static uint32 GetFilterBitIndex( LayerIndex layer_index, NodeIndex node_index );
+    void AddToFilter( LayerIndex layer_index, NodeIndex node_index );
+    bool IsInFilter( LayerIndex layer_index, NodeIndex node_index ) const;
+    void RebuildFilter();
+
+    TMap< int32, FObstacleEntry > Obstacles;
+    // How many obstacles block each free node
+    TMap< FSVONodeAddress, int32 > BlockedNodeCounts;
+    // Union of the sub nodes occluded by the obstacles, for each leaf node
+    TMap< LeafIndex, uint64 > LeafSubNodes;
+    // One bit per hash of the blocked nodes and of the leaves with occluded sub nodes. Most of the nodes away from the obstacles are rejected without looking up the maps
+    TStaticArray< uint64, 64 > BlockedNodeFilter;
+};
+
+FORCEINLINE bool FSVODynamicObstacles::IsEmpty() const
+{
+    return Obstacles.Num() == 0;
+}
+
+FORCEINLINE bool FSVODynamicObstacles::Contains( const int32 obstacle_id ) const
+{
+    return Obstacles.Contains( obstacle_id );
+}
+
+FORCEINLINE uint32 FSVODynamicObstacles::GetFilterBitIndex( const LayerIndex layer_index, const NodeIndex node_index )
+{
+    return GetTypeHash( FSVONodeAddress( layer_index, node_index, 0 ) ) % ( 64 * 64 );
+}
+
+FORCEINLINE void FSVODynamicObstacles::AddToFilter( const LayerIndex layer_index, const NodeIndex node_index )
+{
+    const auto bit_index = GetFilterBitIndex( layer_index, node_index );
+    BlockedNodeFilter[ bit_index / 64 ] |= 1ULL << ( bit_index % 64 );
+}
+
+FORCEINLINE bool FSVODynamicObstacles::IsInFilter( const LayerIndex layer_index, const NodeIndex node_index ) const
+{
+    const auto bit_index = GetFilterBitIndex( layer_index, node_index );
+    return ( BlockedNodeFilter[ bit_index / 64 ] & 1ULL << ( bit_index % 64 ) ) != 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "SVONavigationTypes.h"
+
+#include <CoreMinimal.h>
+
+class FSVOVolumeNavigationData;
+
+/*
+ * Stores the generated navigation data of the volumes on disk, in the intermediate folder of the project.
+ * The files are named after a hash of everything the generation depends on, so the volumes whose collision did not change are loaded instead of being generated again.
+ */
+class SVONAVIGATION_API FSVOGenerationCache
+{
+public:
+    // Must be called on the game thread. Hashes the collision of the components which overlap the navigation bounds of the volume, and the generation settings
+    static FString ComputeKey( const UWorld & world, const FBox & volume_bounds, const FSVODataGenerationSettings & generation_settings, float voxel_extent );
+    static bool Contains( const FString & key );
+    static bool Load( FSVOVolumeNavigationData & volume_navigation_data, const FString & key );
+    static void Save( FSVOVolumeNavigationData & volume_navigation_data, const FString & key );
+
+private:
+    static FString GetFilePath( const FString & key );
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+class FSVOData;
+class FSVOGenerationState;
+
+// What the generation of a volume cost, to track the build performance of the maps over time
+struct SVONAVIGATION_API FSVOGenerationReport
+{
+    FSVOGenerationReport();
+
+    static FSVOGenerationReport Make( const FBox & volume_bounds, const FSVOData & data, const FSVOGenerationState & generation_state, bool is_update, bool is_loaded_from_cache );
+    static FString GetCSVHeader();
+
+    float GetPartiallyOccludedLeafRatio() const;
+    FString ToCSVRow() const;
+    FString ToString() const;
+
+    FBox VolumeBounds;
+    bool bIsUpdate;
+    bool bIsLoadedFromCache;
+    // In seconds
+    double FirstPassTime;
+    double LeafRasterizationTime;
+    double LayersTime;
+    double NeighborLinksTime;
+    int32 OverlapQueryCount;
+    int32 LeafCount;
+    int32 PartiallyOccludedLeafCount;
+    // In bytes
+    int64 PeakAllocatedSize;
+    int64 AllocatedSize;
+};
+
+FORCEINLINE float FSVOGenerationReport::GetPartiallyOccludedLeafRatio() const
+{
+    return LeafCount > 0 ? static_cast< float >( PartiallyOccludedLeafCount ) / LeafCount : 0.0f;
+}
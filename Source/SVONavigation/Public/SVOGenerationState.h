@@ -0,0 +1,117 @@
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Containers/StaticArray.h>
+
+#include <atomic>
+
+enum class ESVOGenerationPhase : uint8
+{
+    Pending,
+    FirstPass,
+    LeafRasterization,
+    // Creates the nodes of the upper layers, and the links between the parents and their children
+    Layers,
+    NeighborLinks,
+    Done
+};
+
+/*
+ * Shared between the game thread and the task which generates the navigation data of a volume.
+ * The task reports its progress, and stops as soon as possible once cancelled.
+ */
+class SVONAVIGATION_API FSVOGenerationState
+{
+public:
+    FSVOGenerationState();
+
+    void Cancel();
+    bool IsCancelled() const;
+
+    void BeginPhase( ESVOGenerationPhase phase, int32 node_count );
+    void AddNodesToProcess( int32 node_count );
+    void AddProcessedNodes( int32 node_count );
+    void AddOverlapQueries( int32 query_count );
+    void UpdatePeakAllocatedSize( int64 allocated_size );
+
+    ESVOGenerationPhase GetPhase() const;
+    int32 GetNodeCount() const;
+    int32 GetProcessedNodeCount() const;
+    // Between 0 and 1, for the whole generation
+    float GetProgress() const;
+    // The following are only valid once the generation is done
+    double GetPhaseTime( ESVOGenerationPhase phase ) const;
+    int32 GetOverlapQueryCount() const;
+    int64 GetPeakAllocatedSize() const;
+
+private:
+    std::atomic< bool > bIsCancelled;
+    std::atomic< ESVOGenerationPhase > Phase;
+    std::atomic< int32 > NodeCount;
+    std::atomic< int32 > ProcessedNodeCount;
+    std::atomic< int32 > OverlapQueryCount;
+    // Only written by the thread which generates the volume
+    double PhaseStartTime;
+    TStaticArray< double, static_cast< int32 >( ESVOGenerationPhase::Done ) + 1 > PhaseTimes;
+    int64 PeakAllocatedSize;
+};
+
+FORCEINLINE void FSVOGenerationState::Cancel()
+{
+    bIsCancelled.store( true, std::memory_order_relaxed );
+}
+
+FORCEINLINE bool FSVOGenerationState::IsCancelled() const
+{
+    return bIsCancelled.load( std::memory_order_relaxed );
+}
+
+FORCEINLINE void FSVOGenerationState::AddNodesToProcess( const int32 node_count )
+{
+    NodeCount.fetch_add( node_count, std::memory_order_relaxed );
+}
+
+FORCEINLINE void FSVOGenerationState::AddProcessedNodes( const int32 node_count )
+{
+    ProcessedNodeCount.fetch_add( node_count, std::memory_order_relaxed );
+}
+
+FORCEINLINE void FSVOGenerationState::AddOverlapQueries( const int32 query_count )
+{
+    OverlapQueryCount.fetch_add( query_count, std::memory_order_relaxed );
+}
+
+FORCEINLINE void FSVOGenerationState::UpdatePeakAllocatedSize( const int64 allocated_size )
+{
+    PeakAllocatedSize = FMath::Max( PeakAllocatedSize, allocated_size );
+}
+
+FORCEINLINE ESVOGenerationPhase FSVOGenerationState::GetPhase() const
+{
+    return Phase.load( std::memory_order_relaxed );
+}
+
+FORCEINLINE int32 FSVOGenerationState::GetNodeCount() const
+{
+    return NodeCount.load( std::memory_order_relaxed );
+}
+
+FORCEINLINE int32 FSVOGenerationState::GetProcessedNodeCount() const
+{
+    return ProcessedNodeCount.load( std::memory_order_relaxed );
+}
+
+FORCEINLINE double FSVOGenerationState::GetPhaseTime( const ESVOGenerationPhase phase ) const
+{
+    return PhaseTimes[ static_cast< int32 >( phase ) ];
+}
+
+FORCEINLINE int32 FSVOGenerationState::GetOverlapQueryCount() const
+{
+    return OverlapQueryCount.load( std::memory_order_relaxed );
+}
+
+FORCEINLINE int64 FSVOGenerationState::GetPeakAllocatedSize() const
+{
+    return PeakAllocatedSize;
+}
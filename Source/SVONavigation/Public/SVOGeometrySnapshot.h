@@ -0,0 +1,116 @@
+#pragma once
+
+#include "SVONavigationTypes.h"
+
+#include <CoreMinimal.h>
+
+class UBodySetup;
+class UPrimitiveComponent;
+
+/*
+ * A copy of the collision geometry which can affect the navigation inside some bounds, stored in a bounding volume hierarchy.
+ * It must be gathered on the game thread, but can then be queried from any thread without touching the physics scene.
+ */
+class SVONAVIGATION_API FSVOGeometrySnapshot
+{
+public:
+    // Returns false when some of the geometry can't be copied (like landscapes), in which case the snapshot must not be used
+    bool Gather( const UWorld & world, const FBox & bounds, const FSVODataGenerationSettings & generation_settings );
+    bool IsBoxOccluded( const FBox & box ) const;
+    // Appends the indices of the primitives whose bounds intersect the box. Used to test many small boxes against the candidates of a bigger box
+    void GatherPrimitives( TArray< int32, TInlineAllocator< 64 > > & primitive_indices, const FBox & box ) const;
+    bool IsBoxOccludedByPrimitive( const FBox & box, int32 primitive_index ) const;
+    const FBox & GetPrimitiveBounds( int32 primitive_index ) const;
+    int32 GetPrimitiveCount() const;
+    int GetAllocatedSize() const;
+
+private:
+    enum class EPrimitiveType : uint8
+    {
+        Box,
+        Sphere,
+        Capsule,
+        Convex,
+        Triangle
+    };
+
+    struct FPrimitive
+    {
+        FBox Bounds;
+        EPrimitiveType Type;
+        int32 DataIndex;
+    };
+
+    // Not necessarily a box, as non uniform scales can shear the collision boxes
+    struct FParallelepiped
+    {
+        FVector Center;
+        FVector HalfAxes[ 3 ];
+    };
+
+    struct FSphere
+    {
+        FVector Center;
+        float Radius;
+    };
+
+    struct FCapsule
+    {
+        FVector Start;
+        FVector End;
+        float Radius;
+    };
+
+    struct FConvex
+    {
+        int32 FirstPlaneIndex;
+        int32 PlaneCount;
+    };
+
+    struct FTriangle
+    {
+        FVector Vertices[ 3 ];
+    };
+
+    struct FBVHNode
+    {
+        FBox Bounds;
+        int32 LeftChildIndex;
+        int32 RightChildIndex;
+        int32 FirstPrimitiveIndex;
+        int32 PrimitiveCount;
+    };
+
+    bool AddComponent( const UPrimitiveComponent & component, const FTransform & transform, bool trace_complex );
+    bool AddBodySetup( const UBodySetup & body_setup, const FTransform & transform, bool trace_complex );
+    void AddParallelepiped( const FVector & center, const FVector & half_axis_x, const FVector & half_axis_y, const FVector & half_axis_z );
+    void AddSphere( const FVector & center, float radius );
+    void AddCapsule( const FVector & start, const FVector & end, float radius );
+    void AddConvex( const TArray< FVector > & vertices, const TArray< int32 > & indices );
+    void AddTriangle( const FVector & a, const FVector & b, const FVector & c );
+    void AddPrimitive( const FBox & bounds, EPrimitiveType type, int32 data_index );
+    void BuildBVH();
+    int32 BuildBVHNode( int32 first_primitive_index, int32 primitive_count );
+
+    FBox Bounds;
+    TArray< FPrimitive > Primitives;
+    TArray< FParallelepiped > Parallelepipeds;
+    TArray< FSphere > Spheres;
+    TArray< FCapsule > Capsules;
+    TArray< FConvex > Convexes;
+    TArray< FPlane > ConvexPlanes;
+    TArray< FTriangle > Triangles;
+    TArray< FBVHNode > BVHNodes;
+    // Indices in Primitives, sorted such as the primitives of each BVH leaf are contiguous
+    TArray< int32 > PrimitiveIndices;
+};
+
+FORCEINLINE const FBox & FSVOGeometrySnapshot::GetPrimitiveBounds( const int32 primitive_index ) const
+{
+    return Primitives[ primitive_index ].Bounds;
+}
+
+FORCEINLINE int32 FSVOGeometrySnapshot::GetPrimitiveCount() const
+{
+    return Primitives.Num();
+}
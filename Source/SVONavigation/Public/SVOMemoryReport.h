@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CoreMinimal.h>
+
+class ASVONavigationData;
+class FSVOVolumeNavigationData;
+
+// In bytes. The allocated sizes include the slack of the arrays
+struct SVONAVIGATION_API FSVOLayerMemoryReport
+{
+    FSVOLayerMemoryReport();
+
+    int64 GetAllocatedSize() const;
+    FString ToString() const;
+
+    int32 NodeCount;
+    int64 MortonCodesSize;
+    int64 FirstChildrenSize;
+    int64 NeighborsSize;
+    int64 ParentsSize;
+    int64 MortonCodeIndexSize;
+    // The part of the node arrays which is allocated but not used
+    int64 SlackSize;
+};
+
+struct SVONAVIGATION_API FSVOVolumeMemoryReport
+{
+    FSVOVolumeMemoryReport();
+
+    static FSVOVolumeMemoryReport Make( const FSVOVolumeNavigationData & volume_navigation_data );
+
+    int64 GetAllocatedSize() const;
+    FString ToString() const;
+
+    FBox VolumeBounds;
+    bool bIsInNavigationDataChunk;
+    TArray< FSVOLayerMemoryReport > Layers;
+    int64 LeafNodesSize;
+    // All the octree, including the layers and the leaf nodes
+    int64 DataSize;
+    int64 DynamicObstaclesSize;
+};
+
+// The memory used by the navigation data of an actor, to size the servers and to catch leaks
+struct SVONAVIGATION_API FSVONavigationDataMemoryReport
+{
+    FSVONavigationDataMemoryReport();
+
+    // Must be called on the game thread
+    static FSVONavigationDataMemoryReport Make( const ASVONavigationData & navigation_data );
+    // Called by each path finding query once done, with the size of its node pool and open list
+    static void AddPathFindingNodePool( int64 allocated_size );
+    static int64 GetLargestPathFindingNodePoolSize();
+
+    int64 GetAllocatedSize() const;
+    FString ToString() const;
+
+    TArray< FSVOVolumeMemoryReport > Volumes;
+    // The copies of the volumes held by the navigation data chunks of the loaded levels share their octree with the volumes. Only the octrees which are not shared are counted
+    int32 ChunkVolumeCount;
+    int64 ChunksSize;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SVOGenerationReport.h"
 #include "SVONavigationTypes.h"
 #include "SVOVolumeNavigationData.h"
 
@@ -102,6 +103,8 @@ public:
 
     const FSVOVolumeNavigationDataDebugInfos & GetDebugInfos() const;
     const TArray< FSVOVolumeNavigationData > & GetVolumeNavigationData() const;
+    // The report of the last generation of each volume, filled by the generator
+    const TArray< FSVOGenerationReport > & GetGenerationReports() const;
 
     void PostInitProperties() override;
     void PostLoad() override;
@@ -158,7 +161,27 @@ public:
     }
 
     void AddVolumeNavigationData( FSVOVolumeNavigationData data );
+    void AddGenerationReport( const FSVOGenerationReport & report );
+
+    // Blocks the navigation data inside the box until the obstacle is removed, without generating the data again. Returns the id of the obstacle
+    UFUNCTION( BlueprintCallable, Category = "SVONavigation" )
+    int32 AddDynamicObstacleBox( const FBox & box );
+
+    // Blocks the navigation data inside the sphere until the obstacle is removed, without generating the data again. Returns the id of the obstacle
+    UFUNCTION( BlueprintCallable, Category = "SVONavigation" )
+    int32 AddDynamicObstacleSphere( const FVector & center, float radius );
+
+    UFUNCTION( BlueprintCallable, Category = "SVONavigation" )
+    bool RemoveDynamicObstacle( int32 obstacle_id );
     const FSVOVolumeNavigationData * GetVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const;
+    // Can be called from any thread. The copy shares the octree of the volume, so the queries can run on it without holding the lock while the game thread replaces the volumes
+    TOptional< FSVOVolumeNavigationData > CopyVolumeNavigationDataContainingPoints( const TArray< FVector > & points ) const;
+    // Finds the node of each position in the first volume which contains it. Can be called from any thread. One result per position, in the same order
+    void GetNodeAddressesFromPositions( TArray< FSVONodeAddressFromPosition > & results, const TArray< FVector > & positions ) const;
+    // Constant time. Can be called from any thread, like CopyVolumeNavigationDataContainingPoints.
+    // Returns an empty optional when the reference does not point to an existing node, or when its volume was generated again or removed since the reference was built
+    TOptional< FSVOVolumeNavigationData > CopyVolumeNavigationDataFromNodeRef( FSVONodeAddress & node_address, NavNodeRef node_ref ) const;
+    USVONavigationDataChunk * GetNavigationDataChunk( ULevel * level ) const;
     void UpdateNavVersion();
 
 private:
@@ -168,6 +191,13 @@ private:
     void UpdateDrawing() const;
     void ResetGenerator( bool cancel_build = true );
     void OnNavigationDataUpdatedInBounds( const TArray< FBox > & updated_bounds );
+    int32 AddDynamicObstacle( const FSVODynamicObstacle & obstacle );
+    // Calls update_volume on a copy of each volume, and replaces the volumes for which it returns true
+    void UpdateVolumesDynamicObstacles( TFunctionRef< bool( FSVOVolumeNavigationData & ) > update_volume );
+    void RegisterDynamicObstacles( FSVOVolumeNavigationData & data ) const;
+    // Called after the volumes are added, removed or replaced, with the write lock held
+    void UpdateVolumeSerials();
+    void InvalidatePathsCrossingObstacle( const FSVODynamicObstacle & obstacle );
 
     UFUNCTION( CallInEditor )
     void ClearNavigationData();
@@ -177,7 +207,11 @@ private:
 
     void InvalidateAffectedPaths( const TArray< FBox > & updated_bounds );
     void OnNavigationDataGenerationFinished();
-    USVONavigationDataChunk * GetNavigationDataChunk( ULevel * level ) const;
+    // The memory report walks all the volumes and chunks, so it is only made again after the data changed
+    void RequestMemoryStatsUpdate();
+    // Only does something when the stats are collected and an update was requested
+    void UpdateMemoryStats();
+    void ResetMemoryStats();
 
     static FPathFindingResult FindPath( const FNavAgentProperties & agent_properties, const FPathFindingQuery & path_finding_query );
 
@@ -193,7 +227,28 @@ private:
     UPROPERTY( EditAnywhere, Category = "Generation", config, meta = ( ClampMin = "0", UIMin = "0" ), AdvancedDisplay )
     int32 MaxSimultaneousBoxGenerationJobsCount;
 
+    // Maximum time in milliseconds spent each frame on the game thread to start and finish the generation tasks in game worlds. 0 means no limit
+    UPROPERTY( EditAnywhere, Category = "Runtime", config, meta = ( ClampMin = "0", UIMin = "0" ) )
+    float RuntimeGenerationTimeBudget;
+
+    // Frame time in milliseconds above which fewer generation tasks run at the same time in game worlds. 0 means the frame time is ignored
+    UPROPERTY( EditAnywhere, Category = "Runtime", config, meta = ( ClampMin = "0", UIMin = "0" ) )
+    float RuntimeGenerationTargetFrameTime;
+
     TArray< FSVOVolumeNavigationData > VolumeNavigationData;
+    // Only held to copy or replace the volumes: the path queries copy their volume and run without the lock, so publishing the data of a volume doesn't wait for them
+    mutable FRWLock VolumeNavigationDataLock;
+    // For each index ever used in VolumeNavigationData, the octree id of the volume last seen at that index and the serial given to it.
+    // The serial of an index only changes when another octree takes it, so it takes 4096 changes of the same volume before an old reference matches again
+    TArray< TPair< uint64, uint32 > > VolumeSerials;
+    // Registered again on the navigation data of the volumes each time it is generated or streamed in
+    TMap< int32, FSVODynamicObstacle > DynamicObstacles;
+    int32 NextDynamicObstacleId;
+    TArray< FSVOGenerationReport > GenerationReports;
+    // What this actor added to the memory stats, so the stats of several actors add up
+    int64 ReportedVolumesMemorySize;
+    int64 ReportedChunksMemorySize;
+    bool bMemoryStatsNeedUpdate;
     ESVOVersion Version;
 };
 
@@ -202,6 +257,11 @@ FORCEINLINE const TArray< FSVOVolumeNavigationData > & ASVONavigationData::GetVo
     return VolumeNavigationData;
 }
 
+FORCEINLINE const TArray< FSVOGenerationReport > & ASVONavigationData::GetGenerationReports() const
+{
+    return GenerationReports;
+}
+
 FORCEINLINE const FSVOVolumeNavigationDataDebugInfos & ASVONavigationData::GetDebugInfos() const
 {
     return DebugInfos;
@@ -6,15 +6,21 @@
 #include <AI/NavDataGenerator.h>
 
 class ASVONavigationData;
+class FSVOGeometrySnapshot;
 
 class FSVONavigationDataGenerator;
 
 struct FSVOVolumeNavigationDataGenerator final : public FNoncopyable
 {
 public:
-    FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds );
+    FSVOVolumeNavigationDataGenerator( FSVONavigationDataGenerator & navigation_data_generator, const FBox & volume_bounds, const TArray< FBox > & dirty_areas );
 
-    FSVOVolumeNavigationData GetBoundsNavigationData() const;
+    // Non const so the generated data can be moved out once the task is done
+    FSVOVolumeNavigationData & GetBoundsNavigationData();
+    const TArray< FBox > & GetDirtyAreas() const;
+    const FSVOGenerationState & GetGenerationState() const;
+    const FSVOGenerationReport & GetGenerationReport() const;
+    void Cancel();
 
     bool DoWork();
 
@@ -22,15 +28,42 @@ private:
     FSVONavigationDataGenerator & ParentGenerator;
     FSVOVolumeNavigationData BoundsNavigationData;
     FBox VolumeBounds;
+    // When not empty, the existing navigation data of the volume is updated instead of generated from scratch
+    TArray< FBox > DirtyAreas;
     TWeakObjectPtr< UWorld > World;
     FNavDataConfig NavDataConfig;
+    TSharedPtr< const FSVOGeometrySnapshot, ESPMode::ThreadSafe > GeometrySnapshot;
+    // When not empty, the data is loaded from the generation cache if it contains that key, and saved in it otherwise
+    FString GenerationCacheKey;
+    TSharedRef< FSVOGenerationState, ESPMode::ThreadSafe > GenerationState;
+    FSVOGenerationReport GenerationReport;
 };
 
-FORCEINLINE FSVOVolumeNavigationData FSVOVolumeNavigationDataGenerator::GetBoundsNavigationData() const
+FORCEINLINE FSVOVolumeNavigationData & FSVOVolumeNavigationDataGenerator::GetBoundsNavigationData()
 {
     return BoundsNavigationData;
 }
 
+FORCEINLINE const TArray< FBox > & FSVOVolumeNavigationDataGenerator::GetDirtyAreas() const
+{
+    return DirtyAreas;
+}
+
+FORCEINLINE const FSVOGenerationState & FSVOVolumeNavigationDataGenerator::GetGenerationState() const
+{
+    return *GenerationState;
+}
+
+FORCEINLINE const FSVOGenerationReport & FSVOVolumeNavigationDataGenerator::GetGenerationReport() const
+{
+    return GenerationReport;
+}
+
+FORCEINLINE void FSVOVolumeNavigationDataGenerator::Cancel()
+{
+    GenerationState->Cancel();
+}
+
 struct SVONAVIGATION_API FSVOBoxGeneratorWrapper : public FNonAbandonableTask
 {
     TSharedRef< FSVOVolumeNavigationDataGenerator > BoxNavigationDataGenerator;
@@ -56,6 +89,8 @@ typedef FAsyncTask< FSVOBoxGeneratorWrapper > FSVOBoxGeneratorTask;
 struct FPendingBoundsDataGenerationElement
 {
     FBox VolumeBounds;
+    // Empty when the whole volume must be generated
+    TArray< FBox > DirtyAreas;
     float SeedDistance;
 
     FPendingBoundsDataGenerationElement() :
@@ -89,6 +124,7 @@ struct FRunningBoundsDataGenerationElement
 {
     FRunningBoundsDataGenerationElement() :
         VolumeBounds( EForceInit::ForceInit ),
+        SeedDistance( MAX_flt ),
         ShouldDiscard( false ),
         AsyncTask( nullptr )
     {
@@ -96,6 +132,7 @@ struct FRunningBoundsDataGenerationElement
 
     FRunningBoundsDataGenerationElement( const FBox & volume_bounds ) :
         VolumeBounds( volume_bounds ),
+        SeedDistance( MAX_flt ),
         ShouldDiscard( false ),
         AsyncTask( nullptr )
     {
@@ -106,12 +143,36 @@ struct FRunningBoundsDataGenerationElement
         return VolumeBounds == other.VolumeBounds;
     }
 
+    // Asks the task to stop as soon as possible, and discards its results
+    void Cancel();
+
     FBox VolumeBounds;
+    float SeedDistance;
     /** whether generated results should be discarded */
     bool ShouldDiscard;
     FSVOBoxGeneratorTask * AsyncTask;
 };
 
+FORCEINLINE void FRunningBoundsDataGenerationElement::Cancel()
+{
+    ShouldDiscard = true;
+
+    if ( AsyncTask != nullptr )
+    {
+        AsyncTask->GetTask().BoxNavigationDataGenerator->Cancel();
+    }
+}
+
+struct FSVOVolumeGenerationProgress
+{
+    FBox VolumeBounds;
+    ESVOGenerationPhase Phase;
+    int32 NodeCount;
+    int32 ProcessedNodeCount;
+    // Between 0 and 1
+    float Progress;
+};
+
 class SVONAVIGATION_API FSVONavigationDataGenerator final : public FNavDataGenerator, public FNoncopyable
 {
 public:
@@ -133,16 +194,27 @@ public:
     int32 GetNumRemaningBuildTasks() const override;
     int32 GetNumRunningBuildTasks() const override;
 
+    void GetRunningTasksProgress( TArray< FSVOVolumeGenerationProgress > & tasks_progress ) const;
+    // Between 0 and 1. The share of the volumes to generate since the build started which are generated, including the progress of the running tasks
+    float GetBuildProgress() const;
+
 private:
-    void GetSeedLocations( TArray< FVector2D > & seed_locations, UWorld & world ) const;
+    void GetSeedLocations( TArray< FVector > & seed_locations, UWorld & world ) const;
     void SortPendingBounds();
+    void UpdateMaximumGeneratorTaskCount();
+    void PreemptFarthestRunningTask();
     void UpdateNavigationBounds();
-    TArray< FBox > ProcessAsyncTasks( int32 task_to_process_count );
-    TSharedRef< FSVOVolumeNavigationDataGenerator > CreateBoxNavigationGenerator( const FBox & box );
+    TArray< FBox > ProcessAsyncTasks( int32 task_to_process_count, float time_budget = 0.0f );
+    TSharedRef< FSVOVolumeNavigationDataGenerator > CreateBoxNavigationGenerator( const FBox & box, const TArray< FBox > & dirty_areas );
 
     ASVONavigationData & NavigationData;
     FSVODataGenerationSettings GenerationSettings;
     int MaximumGeneratorTaskCount;
+    // Lowered in game worlds when the frame time goes above the target frame time of the navigation data
+    int32 CurrentMaximumGeneratorTaskCount;
+    float TimeUntilPendingBoundsSort;
+    // The number of tasks finished since the build started. Used to compute the progress of the build
+    int32 FinishedTaskCount;
     uint8 IsInitialized : 1;
 
     /** Total bounding box that includes all volumes, in unreal units. */
@@ -19,6 +19,11 @@ public:
     UPROPERTY( config, EditAnywhere, Category = "SVO Navigation" )
     uint8 bNavigationAutoUpdateEnabled : 1;
 
+    // When enabled, the navigation data is compressed when saved, which makes the maps smaller, but the data must be decompressed and its links built again when loaded.
+    // Otherwise it is saved as it is in memory, and loading it only copies it.
+    UPROPERTY( config, EditAnywhere, Category = "SVO Navigation" )
+    uint8 bCompressNavigationData : 1;
+
     // The algorithm to use to detect if there's a direct line of sight between the start of tha path and the target
     // If there's a direct LoS, the generated path will be a straight line from start to target.
     // Otherwise the pathfinding algorithm will be executed.
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <HAL/LowLevelMemTracker.h>
+#include <Stats/Stats.h>
+
+LLM_DECLARE_TAG_API( SVONavigation, SVONAVIGATION_API );
+
+DECLARE_STATS_GROUP( TEXT( "SVONavigation" ), STATGROUP_SVONavigation, STATCAT_Advanced );
+
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Generate volume" ), STAT_SVONavigation_GenerateVolume, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Update volume" ), STAT_SVONavigation_UpdateVolume, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "First pass rasterization" ), STAT_SVONavigation_FirstPassRasterization, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Leaf rasterization" ), STAT_SVONavigation_LeafRasterization, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Layers" ), STAT_SVONavigation_Layers, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Neighbor links" ), STAT_SVONavigation_NeighborLinks, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN( TEXT( "Overlap queries" ), STAT_SVONavigation_OverlapQueries, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN( TEXT( "Generated volumes" ), STAT_SVONavigation_GeneratedVolumes, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Volumes memory" ), STAT_SVONavigation_VolumesMemory, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Navigation data chunks memory" ), STAT_SVONavigation_ChunksMemory, STATGROUP_SVONavigation, SVONAVIGATION_API );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Largest path finding node pool" ), STAT_SVONavigation_PathFindingNodePoolMemory, STATGROUP_SVONavigation, SVONAVIGATION_API );
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Algo/BinarySearch.h>
 #include <CoreMinimal.h>
 
 #include "SVONavigationTypes.generated.h"
@@ -7,6 +8,7 @@
 class USVOPathFindingAlgorithm;
 class USVOPathHeuristicCalculator;
 class USVOPathTraversalCostCalculator;
+struct FSVOLayerMemoryReport;
 
 typedef uint_fast64_t MortonCode;
 typedef uint8 LayerIndex;
@@ -26,6 +28,11 @@ struct FSVODataGenerationSettings
     {
         CollisionChannel = ECollisionChannel::ECC_WorldStatic;
         Clearance = 0.0f;
+        bUseParallelRasterization = true;
+        bUseGeometrySnapshot = false;
+        bBuildMortonCodeIndex = true;
+        bStoreNeighborLinks = true;
+        bUseGenerationCache = false;
 
         CollisionQueryParameters.bFindInitialOverlaps = true;
         CollisionQueryParameters.bTraceComplex = false;
@@ -38,6 +45,28 @@ struct FSVODataGenerationSettings
     UPROPERTY( EditAnywhere, Category = "Generation" )
     float Clearance;
 
+    // When enabled, the overlap queries used to rasterize a volume and the construction of the neighbor links are spread on the task graph instead of running on the single thread which generates the volume.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bUseParallelRasterization : 1;
+
+    // When enabled, the collision geometry of each volume is copied on the game thread before the generation starts, and the rasterization runs against that copy instead of the physics scene.
+    // The volumes which overlap some collision which can't be copied (like landscapes) still use the physics scene
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bUseGeometrySnapshot : 1;
+
+    // When enabled, each layer stores one bit per node of its parent layer to find its nodes from their morton code in constant time, instead of searching them.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bBuildMortonCodeIndex : 1;
+
+    // When disabled, the nodes don't store the links to their 6 neighbors, which are found from the morton codes of the nodes each time they are queried instead.
+    // This almost halves the memory used by the octree, at the cost of slower path finding. The morton code indices are then always kept, to find the neighbors in constant time.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bStoreNeighborLinks : 1;
+
+    // Editor only. When enabled, the generated data of each volume is saved in the intermediate folder, and loaded instead of being generated again as long as the collision inside the volume and the settings don't change.
+    UPROPERTY( EditAnywhere, Category = "Generation" )
+    uint8 bUseGenerationCache : 1;
+
     FCollisionQueryParams CollisionQueryParameters;
 };
 
@@ -50,10 +79,11 @@ struct FSVONodeAddress
     {
     }
 
-    explicit FSVONodeAddress( const int32 index ) :
-        LayerIndex( index << 28 ),
-        NodeIndex( index << 6 ),
-        SubNodeIndex( index )
+    // Ignores the volume index and serial stored in the upper bits of the reference
+    explicit FSVONodeAddress( const NavNodeRef node_ref ) :
+        LayerIndex( node_ref >> 37 & 0xF ),
+        NodeIndex( node_ref >> 6 & 0x7FFFFFFF ),
+        SubNodeIndex( node_ref & 0x3F )
     {
     }
 
@@ -77,24 +107,47 @@ struct FSVONodeAddress
         return !operator==( other );
     }
 
-    NavNodeRef GetNavNodeRef() const
+    // The node indices of a layer fit in 31 bits as the layers are stored in TArrays, so the address takes the lower 41 bits.
+    // The volume index is stored in the next 11 bits, offset by one so a valid reference is never INVALID_NAVNODEREF.
+    // The upper 12 bits store the serial of the volume, so the references to a volume which was generated again, or to the volume which had that index before, can be rejected.
+    // Only the first 2047 volumes have node references: returns INVALID_NAVNODEREF for the others
+    NavNodeRef GetNavNodeRef( const int32 volume_index, const uint32 volume_serial ) const
+    {
+        if ( volume_index < 0 || volume_index >= ( 1 << 11 ) - 1 )
+        {
+            return INVALID_NAVNODEREF;
+        }
+
+        return static_cast< NavNodeRef >( volume_serial & 0xFFF ) << 52 | static_cast< NavNodeRef >( volume_index + 1 ) << 41 | static_cast< NavNodeRef >( LayerIndex ) << 37 | static_cast< NavNodeRef >( NodeIndex & 0x7FFFFFFF ) << 6 | static_cast< NavNodeRef >( SubNodeIndex );
+    }
+
+    // Returns INDEX_NONE when the reference was not built with GetNavNodeRef
+    static int32 GetVolumeIndexFromNavNodeRef( const NavNodeRef node_ref )
     {
-        const int32 address = LayerIndex << 28 | NodeIndex << 6 | SubNodeIndex;
-        return static_cast< NavNodeRef >( address );
+        return static_cast< int32 >( node_ref >> 41 & 0x7FF ) - 1;
+    }
+
+    // Only compares the lower 12 bits of the serial: a reference built before 4096 changes of the same volume matches again
+    static bool DoesNavNodeRefMatchVolumeSerial( const NavNodeRef node_ref, const uint32 volume_serial )
+    {
+        return ( node_ref >> 52 ) == ( volume_serial & 0xFFF );
     }
 
     FString ToString() const
     {
-        return FString::Printf( TEXT( "%i %i %i" ), LayerIndex, NodeIndex, SubNodeIndex );
+        return FString::Printf( TEXT( "%u %u %u" ), static_cast< uint32 >( LayerIndex ), static_cast< uint32 >( NodeIndex ), static_cast< uint32 >( SubNodeIndex ) );
     }
 
     static const FSVONodeAddress InvalidAddress;
 
-    uint8 LayerIndex        : 4;
-    uint_fast32_t NodeIndex : 22;
-    uint8 SubNodeIndex      : 6;
+    // 64 bits, so the layers are not limited to 4M nodes
+    uint64 LayerIndex   : 4;
+    uint64 NodeIndex    : 32;
+    uint64 SubNodeIndex : 6;
 };
 
+static_assert( sizeof( FSVONodeAddress ) == sizeof( uint64 ), "FSVONodeAddress is serialized as raw bytes" );
+
 FORCEINLINE bool FSVONodeAddress::IsValid() const
 {
     return LayerIndex != 15;
@@ -107,7 +160,7 @@ FORCEINLINE void FSVONodeAddress::Invalidate()
 
 FORCEINLINE uint32 GetTypeHash( const FSVONodeAddress & address )
 {
-    return HashCombine( HashCombine( GetTypeHash( address.LayerIndex ), GetTypeHash( address.NodeIndex ) ), GetTypeHash( address.SubNodeIndex ) );
+    return HashCombine( HashCombine( GetTypeHash( static_cast< uint8 >( address.LayerIndex ) ), GetTypeHash( static_cast< uint32 >( address.NodeIndex ) ) ), GetTypeHash( static_cast< uint8 >( address.SubNodeIndex ) ) );
 }
 
 FORCEINLINE FArchive & operator<<( FArchive & archive, FSVONodeAddress & data )
@@ -124,7 +177,6 @@ struct FSVOLeafNode
     bool IsCompletelyFree() const;
 
     uint_fast64_t SubNodes = 0;
-    FSVONodeAddress Parent;
 };
 
 FORCEINLINE void FSVOLeafNode::MarkSubNodeAsOccluded( const SubNodeIndex index )
@@ -147,13 +199,6 @@ FORCEINLINE bool FSVOLeafNode::IsCompletelyFree() const
     return SubNodes == 0;
 }
 
-FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOLeafNode & data )
-{
-    archive << data.SubNodes;
-    archive << data.Parent;
-    return archive;
-}
-
 struct FSVONode
 {
     FSVONode();
@@ -190,43 +235,78 @@ FORCEINLINE FArchive & operator<<( FArchive & archive, FSVONode & data )
     return archive;
 }
 
+// The leaves have the index of their layer 0 node, and their parent is the parent of that node.
+// Most leaves are either completely free or completely occluded: those only take 2 bits, and only the partially occluded leaves store their sub nodes
 class FSVOLeafNodes
 {
 public:
-    friend FArchive & operator<<( FArchive & archive, FSVOLeafNodes & leaf_nodes );
     friend class FSVOVolumeNavigationData;
     friend class FSVOData;
 
-    const FSVOLeafNode & GetLeafNode( const LeafIndex leaf_index ) const;
-    const TArray< FSVOLeafNode > & GetLeafNodes() const;
+    FSVOLeafNodes();
+
+    FSVOLeafNode GetLeafNode( const LeafIndex leaf_index ) const;
+    int32 GetLeafNodeCount() const;
+    int32 GetPartiallyOccludedLeafNodeCount() const;
     float GetLeafNodeSize() const;
     float GetLeafNodeExtent() const;
     float GetLeafSubNodeSize() const;
     float GetLeafSubNodeExtent() const;
 
-    int GetAllocatedSize() const;
+    int64 GetAllocatedSize() const;
 
 private:
-    FSVOLeafNode & GetLeafNode( const LeafIndex leaf_index );
+    // The state of 64 consecutive leaves
+    struct FWord
+    {
+        uint64 CompletelyOccludedBits;
+        uint64 PartiallyOccludedBits;
+        // The number of partially occluded leaves in the words before this one
+        uint32 PartiallyOccludedRank;
+    };
 
     void Initialize( float leaf_size );
     void Reset();
-    void AllocateLeafNodes( int leaf_count );
-    void AddLeafNode( LeafIndex leaf_index, SubNodeIndex sub_node_index, bool is_occluded );
-    void AddEmptyLeafNode();
+    // Takes the sub nodes of all the leaves, in the order of their index
+    void Build( const TArray< uint_fast64_t > & sub_nodes );
+    void SerializeFlat( FArchive & archive );
+    // The sub nodes are run length encoded by runs of leaves of the same state
+    void Compress( TArray< uint8 > & bytes ) const;
+    bool Decompress( const TArray< uint8 > & bytes, uint64 max_leaf_count );
 
     float LeafNodeSize;
-    TArray< FSVOLeafNode > LeafNodes;
+    int32 LeafNodeCount;
+    TArray< FWord > Words;
+    TArray< uint_fast64_t > PartiallyOccludedSubNodes;
 };
 
-FORCEINLINE const FSVOLeafNode & FSVOLeafNodes::GetLeafNode( const LeafIndex leaf_index ) const
+FORCEINLINE FSVOLeafNode FSVOLeafNodes::GetLeafNode( const LeafIndex leaf_index ) const
 {
-    return LeafNodes[ leaf_index ];
+    const auto & word = Words[ leaf_index >> 6 ];
+    const auto leaf_bit = 1ULL << ( leaf_index & 63 );
+
+    FSVOLeafNode leaf_node;
+
+    if ( ( word.PartiallyOccludedBits & leaf_bit ) != 0 )
+    {
+        leaf_node.SubNodes = PartiallyOccludedSubNodes[ word.PartiallyOccludedRank + FPlatformMath::CountBits( word.PartiallyOccludedBits & ( leaf_bit - 1 ) ) ];
+    }
+    else if ( ( word.CompletelyOccludedBits & leaf_bit ) != 0 )
+    {
+        leaf_node.SubNodes = -1;
+    }
+
+    return leaf_node;
 }
 
-FORCEINLINE const TArray< FSVOLeafNode > & FSVOLeafNodes::GetLeafNodes() const
+FORCEINLINE int32 FSVOLeafNodes::GetLeafNodeCount() const
 {
-    return LeafNodes;
+    return LeafNodeCount;
+}
+
+FORCEINLINE int32 FSVOLeafNodes::GetPartiallyOccludedLeafNodeCount() const
+{
+    return PartiallyOccludedSubNodes.Num();
 }
 
 FORCEINLINE float FSVOLeafNodes::GetLeafNodeSize() const
@@ -249,62 +329,172 @@ FORCEINLINE float FSVOLeafNodes::GetLeafSubNodeExtent() const
     return GetLeafSubNodeSize() * 0.5f;
 }
 
-FORCEINLINE FSVOLeafNode & FSVOLeafNodes::GetLeafNode( const LeafIndex leaf_index )
+// Starts on a cache line, so the arrays of a layer don't share the cache lines of the other allocations
+template < typename _TYPE_ >
+using TSVOLayerArray = TArray< _TYPE_, TAlignedHeapAllocator< PLATFORM_CACHE_LINE_SIZE > >;
+
+// The nodes of a layer are the 8 children of each node of the parent layer which has children, sorted by morton code.
+// One bit per morton code of the parent layer tells if that node has children, and the number of bits set before each word gives the index of its first child.
+class FSVOMortonCodeIndex
+{
+public:
+    void Build( const TSVOLayerArray< MortonCode > & morton_codes );
+    void Reset();
+    void SerializeFlat( FArchive & archive );
+    bool IsEmpty() const;
+    // Returns INDEX_NONE if the parent of the node has no children. The caller must check the index is in the bounds of the layer
+    int32 GetNodeIndex( MortonCode morton_code ) const;
+
+    int64 GetAllocatedSize() const;
+
+private:
+    TArray< uint64 > Words;
+    // The number of bits set in the words before each word
+    TArray< uint32 > Ranks;
+};
+
+FORCEINLINE bool FSVOMortonCodeIndex::IsEmpty() const
 {
-    return LeafNodes[ leaf_index ];
+    return Words.Num() == 0;
 }
 
-FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOLeafNodes & leaf_nodes )
+FORCEINLINE int32 FSVOMortonCodeIndex::GetNodeIndex( const MortonCode morton_code ) const
 {
-    archive << leaf_nodes.LeafNodes;
-    archive << leaf_nodes.LeafNodeSize;
-    return archive;
+    const auto parent_morton_code = morton_code >> 3;
+    const auto word_index = parent_morton_code >> 6;
+
+    if ( word_index >= static_cast< uint64 >( Words.Num() ) )
+    {
+        return INDEX_NONE;
+    }
+
+    const auto word = Words[ word_index ];
+    const auto parent_bit = 1ULL << ( parent_morton_code & 63 );
+
+    if ( ( word & parent_bit ) == 0 )
+    {
+        return INDEX_NONE;
+    }
+
+    const auto parent_rank = Ranks[ word_index ] + FPlatformMath::CountBits( word & ( parent_bit - 1 ) );
+    return static_cast< int32 >( parent_rank * 8 + ( morton_code & 7 ) );
 }
 
+// The members of the nodes are stored in separate arrays. The path finding mostly reads the child and neighbor links, and the position computations the morton codes,
+// so each of them only loads the cache lines of the members it needs
 class FSVOLayer
 {
 public:
-    friend FArchive & operator<<( FArchive & archive, FSVOLayer & layer );
     friend class FSVOVolumeNavigationData;
+    friend class FSVOData;
 
     FSVOLayer();
-    FSVOLayer( int max_node_count, float node_size );
+    FSVOLayer( uint64 max_node_count, float node_size, bool store_neighbor_links );
 
-    const TArray< FSVONode > & GetNodes() const;
     int32 GetNodeCount() const;
-    const FSVONode & GetNode( NodeIndex node_index ) const;
+    // Gathers all the members of the node. Prefer the accessors of a single member in the hot paths. The neighbors are invalid when the layer does not store the links
+    FSVONode GetNode( NodeIndex node_index ) const;
+    MortonCode GetNodeMortonCode( NodeIndex node_index ) const;
+    const FSVONodeAddress & GetNodeParent( NodeIndex node_index ) const;
+    const FSVONodeAddress & GetNodeFirstChild( NodeIndex node_index ) const;
+    bool HasNodeChildren( NodeIndex node_index ) const;
+    // When false, FSVOVolumeNavigationData finds the neighbors from the morton codes
+    bool HasNeighborLinks() const;
+    // Only valid if the layer has neighbor links
+    const FSVONodeAddress & GetNodeNeighbor( NodeIndex node_index, NeighborDirection direction ) const;
+    // Sorted
+    const TSVOLayerArray< MortonCode > & GetMortonCodes() const;
     float GetNodeSize() const;
     float GetNodeExtent() const;
-    uint32 GetMaxNodeCount() const;
+    uint64 GetMaxNodeCount() const;
+    bool HasMortonCodeIndex() const;
+    // Constant time when the layer has a morton code index, binary search otherwise. Returns INDEX_NONE if no node has that morton code
+    int32 GetNodeIndexFromMortonCode( MortonCode morton_code ) const;
 
-    int GetAllocatedSize() const;
+    int64 GetAllocatedSize() const;
+    // The size of each array of the nodes
+    FSVOLayerMemoryReport GetMemoryReport() const;
 
 private:
-    TArray< FSVONode > & GetNodes();
-
-    TArray< FSVONode > Nodes;
-    int MaxNodeCount;
+    void ReserveNodes( int32 node_count );
+    // The links of the new node are invalid
+    NodeIndex AddNode( MortonCode morton_code );
+    FSVONodeAddress & GetNodeParent( NodeIndex node_index );
+    FSVONodeAddress & GetNodeFirstChild( NodeIndex node_index );
+    FSVONodeAddress & GetNodeNeighbor( NodeIndex node_index, NeighborDirection direction );
+    void BuildMortonCodeIndex();
+    void ResetMortonCodeIndex();
+    // The arrays are read and written in one call each, and used as they are once loaded
+    void SerializeFlat( FArchive & archive, uint64 max_node_count );
+    // The siblings are stored next to each other, so only the morton codes of their parents are saved, and the links to the children as one bit per node.
+    // The parents are linked again by FSVOData, and the neighbors by FSVOVolumeNavigationData
+    void Compress( TArray< uint8 > & bytes, LayerIndex layer_index ) const;
+    bool Decompress( const TArray< uint8 > & bytes, LayerIndex layer_index, uint64 max_node_count );
+
+    TSVOLayerArray< MortonCode > MortonCodes;
+    TSVOLayerArray< FSVONodeAddress > FirstChildren;
+    // 6 per node, in the order of the neighbor directions. Empty if the layer does not store the neighbor links
+    TSVOLayerArray< FSVONodeAddress > Neighbors;
+    TSVOLayerArray< FSVONodeAddress > Parents;
+    FSVOMortonCodeIndex MortonCodeIndex;
+    uint64 MaxNodeCount;
     float NodeSize;
+    uint8 bStoresNeighborLinks : 1;
 };
 
-FORCEINLINE const TArray< FSVONode > & FSVOLayer::GetNodes() const
+FORCEINLINE int32 FSVOLayer::GetNodeCount() const
 {
-    return Nodes;
+    return MortonCodes.Num();
 }
 
-FORCEINLINE TArray< FSVONode > & FSVOLayer::GetNodes()
+FORCEINLINE MortonCode FSVOLayer::GetNodeMortonCode( const NodeIndex node_index ) const
 {
-    return Nodes;
+    return MortonCodes[ node_index ];
 }
 
-FORCEINLINE int32 FSVOLayer::GetNodeCount() const
+FORCEINLINE const FSVONodeAddress & FSVOLayer::GetNodeParent( const NodeIndex node_index ) const
+{
+    return Parents[ node_index ];
+}
+
+FORCEINLINE FSVONodeAddress & FSVOLayer::GetNodeParent( const NodeIndex node_index )
+{
+    return Parents[ node_index ];
+}
+
+FORCEINLINE const FSVONodeAddress & FSVOLayer::GetNodeFirstChild( const NodeIndex node_index ) const
+{
+    return FirstChildren[ node_index ];
+}
+
+FORCEINLINE FSVONodeAddress & FSVOLayer::GetNodeFirstChild( const NodeIndex node_index )
+{
+    return FirstChildren[ node_index ];
+}
+
+FORCEINLINE bool FSVOLayer::HasNodeChildren( const NodeIndex node_index ) const
+{
+    return FirstChildren[ node_index ].IsValid();
+}
+
+FORCEINLINE bool FSVOLayer::HasNeighborLinks() const
 {
-    return Nodes.Num();
+    return bStoresNeighborLinks;
 }
 
-FORCEINLINE const FSVONode & FSVOLayer::GetNode( const NodeIndex node_index ) const
+FORCEINLINE const FSVONodeAddress & FSVOLayer::GetNodeNeighbor( const NodeIndex node_index, const NeighborDirection direction ) const
 {
-    return Nodes[ node_index ];
+    return Neighbors[ node_index * 6 + direction ];
+}
+
+FORCEINLINE FSVONodeAddress & FSVOLayer::GetNodeNeighbor( const NodeIndex node_index, const NeighborDirection direction )
+{
+    return Neighbors[ node_index * 6 + direction ];
+}
+
+FORCEINLINE const TSVOLayerArray< MortonCode > & FSVOLayer::GetMortonCodes() const
+{
+    return MortonCodes;
 }
 
 FORCEINLINE float FSVOLayer::GetNodeSize() const
@@ -317,22 +507,35 @@ FORCEINLINE float FSVOLayer::GetNodeExtent() const
     return GetNodeSize() * 0.5f;
 }
 
-FORCEINLINE uint32 FSVOLayer::GetMaxNodeCount() const
+FORCEINLINE uint64 FSVOLayer::GetMaxNodeCount() const
 {
     return MaxNodeCount;
 }
 
-FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOLayer & layer )
+FORCEINLINE bool FSVOLayer::HasMortonCodeIndex() const
 {
-    archive << layer.Nodes;
-    archive << layer.NodeSize;
-    return archive;
+    return !MortonCodeIndex.IsEmpty();
+}
+
+FORCEINLINE int32 FSVOLayer::GetNodeIndexFromMortonCode( const MortonCode morton_code ) const
+{
+    if ( !HasMortonCodeIndex() )
+    {
+        // Since nodes are ordered, we can use the binary search
+        return Algo::BinarySearch( MortonCodes, morton_code );
+    }
+
+    const auto node_index = MortonCodeIndex.GetNodeIndex( morton_code );
+
+    // INDEX_NONE when the parent has no children. The top layer has a single node, even though its parent has children
+    return node_index != INDEX_NONE && node_index < MortonCodes.Num() && MortonCodes[ node_index ] == morton_code
+               ? node_index
+               : INDEX_NONE;
 }
 
 class FSVOData
 {
 public:
-    friend FArchive & operator<<( FArchive & archive, FSVOData & data );
     friend class FSVOVolumeNavigationData;
 
     FSVOData();
@@ -346,16 +549,23 @@ public:
     bool IsValid() const;
 
     void Reset();
-    int GetAllocatedSize() const;
+    int64 GetAllocatedSize() const;
 
 private:
     FSVOLayer & GetLayer( LayerIndex layer_index );
     FSVOLeafNodes & GetLeafNodes();
-    bool Initialize( float voxel_size, const FBox & volume_bounds );
-    void AddBlockedNode( LayerIndex layer_index, NodeIndex node_index );
-    const TArray< NodeIndex > & GetLayerBlockedNodes( LayerIndex layer_index ) const;
-
-    TArray< TArray< NodeIndex > > BlockedNodes;
+    bool Initialize( float voxel_size, const FBox & volume_bounds, bool store_neighbor_links );
+    void AddBlockedNode( LayerIndex layer_index, MortonCode morton_code );
+    const TArray< MortonCode > & GetLayerBlockedNodes( LayerIndex layer_index ) const;
+    // Only needed until the layers are built
+    void ReleaseBlockedNodes();
+    // The arrays of the nodes as they are in memory. Nothing is done per node when loading, but the files are larger
+    void SerializeFlat( FArchive & archive );
+    // Each layer and the leaves are compressed in their own buffer, so they are compressed and decompressed in parallel. The neighbor links must be built again after loading
+    void SerializeCompressed( FArchive & archive );
+
+    // The morton codes of the nodes which have children, for each layer
+    TArray< TArray< MortonCode > > BlockedNodes;
     TArray< FSVOLayer > Layers;
     FSVOLeafNodes LeafNodes;
     FBox NavigationBounds;
@@ -409,26 +619,7 @@ FORCEINLINE bool FSVOData::IsValid() const
     return bIsValid && GetLayerCount() > 0;
 }
 
-FORCEINLINE const TArray< NodeIndex > & FSVOData::GetLayerBlockedNodes( const LayerIndex layer_index ) const
+FORCEINLINE const TArray< MortonCode > & FSVOData::GetLayerBlockedNodes( const LayerIndex layer_index ) const
 {
     return BlockedNodes[ layer_index ];
 }
-
-FORCEINLINE FArchive & operator<<( FArchive & archive, FSVOData & data )
-{
-    archive << data.Layers;
-    archive << data.LeafNodes;
-    archive << data.NavigationBounds;
-
-    if ( archive.IsLoading() )
-    {
-        data.bIsValid = ( data.Layers.Num() > 0 && data.NavigationBounds.IsValid );
-
-        if ( !data.bIsValid )
-        {
-            data.Reset();
-        }
-    }
-
-    return archive;
-}
\ No newline at end of file
@@ -7,7 +7,13 @@ enum class ESVOVersion : uint8
     LeafNodeParent = 3,
     VolumeNavigationQueryFilter = 4,
     NavigationDataChunks = 5,
+    MortonCodeIndex = 6,
+    StructureOfArraysLayers = 7,
+    CompressedData = 8,
+    FlatData = 9,
+    SparseLeafNodes = 10,
+    WideNodeAddresses = 11,
 
-    MinCompatible = NavigationDataChunks,
-    Latest = NavigationDataChunks
+    MinCompatible = WideNodeAddresses,
+    Latest = WideNodeAddresses
 };
\ No newline at end of file
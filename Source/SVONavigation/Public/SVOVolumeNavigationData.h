@@ -1,9 +1,14 @@
 #pragma once
 
+#include "SVODynamicObstacles.h"
+#include "SVOGenerationState.h"
+#include "SVONavigationStats.h"
 #include "SVONavigationTypes.h"
 
+#include <Containers/StaticArray.h>
 #include <Templates/SubclassOf.h>
 
+class FSVOGeometrySnapshot;
 class UNavigationQueryFilter;
 class USVONavigationQueryFilter;
 enum class ESVOVersion : uint8;
@@ -15,6 +20,25 @@ struct FSVOVolumeNavigationDataGenerationSettings
     float VoxelExtent;
     UWorld * World;
     FSVODataGenerationSettings GenerationSettings;
+    // When set, used instead of the physics scene of World to rasterize the volume
+    TSharedPtr< const FSVOGeometrySnapshot, ESPMode::ThreadSafe > GeometrySnapshot;
+    // When set, receives the progress of the generation, and can cancel it
+    TSharedPtr< FSVOGenerationState, ESPMode::ThreadSafe > GenerationState;
+};
+
+// The node which contains a position, returned by the batched queries
+struct SVONAVIGATION_API FSVONodeAddressFromPosition
+{
+    FSVONodeAddressFromPosition();
+
+    // Invalid when the position is outside the navigation bounds
+    FSVONodeAddress NodeAddress;
+    // Only set by ASVONavigationData, INDEX_NONE when no volume contains the position
+    int32 VolumeIndex;
+    // Only set by ASVONavigationData, INVALID_NAVNODEREF when NodeAddress is invalid
+    NavNodeRef NodeRef;
+    // The position is in an occluded sub node, or in a node blocked by a dynamic obstacle. NodeAddress is still the node which contains it
+    bool bIsOccluded;
 };
 
 class SVONAVIGATION_API FSVOVolumeNavigationData
@@ -22,7 +46,7 @@ class SVONAVIGATION_API FSVOVolumeNavigationData
 public:
     typedef FSVONodeAddress FNodeRef;
 
-    FSVOVolumeNavigationData() = default;
+    FSVOVolumeNavigationData();
 
     // Used by FGraphAStar
     bool IsValidRef( const FSVONodeAddress ref ) const
@@ -36,42 +60,101 @@ public:
     const FBox & GetVolumeBounds() const;
     const FBox & GetNavigationBounds() const;
     const FSVOData & GetData() const;
-    const FSVONode & GetNodeFromAddress( const FSVONodeAddress & address ) const;
+    // Changes each time the octree is replaced
+    uint64 GetOctreeId() const;
+    // Set by the navigation data which owns the volume, and only changed when another octree takes the index of the volume. Stored in the node references, to reject the references to a previous octree
+    uint32 GetSerial() const;
+    void SetSerial( uint32 serial );
+    // The reference identifies the volume with volume_index and with the serial of the volume
+    NavNodeRef GetNavNodeRef( const FSVONodeAddress & address, int32 volume_index ) const;
+    FSVONode GetNodeFromAddress( const FSVONodeAddress & address ) const;
     TSubclassOf< USVONavigationQueryFilter > GetVolumeNavigationQueryFilter() const;
     void SetVolumeNavigationQueryFilter( TSubclassOf< USVONavigationQueryFilter > navigation_query_filter );
 
     FVector GetNodePositionFromAddress( const FSVONodeAddress & address, bool try_get_sub_node_position ) const;
     FVector GetNodePositionFromLayerAndMortonCode( LayerIndex layer_index, MortonCode morton_code ) const;
     FVector GetLeafNodePositionFromMortonCode( MortonCode morton_code ) const;
+    // Goes down one node per layer, using the octant of the position in each node to find its child
     bool GetNodeAddressFromPosition( FSVONodeAddress & node_address, const FVector & position ) const;
+    // Same as calling GetNodeAddressFromPosition for each position, but the positions are sorted by morton code so each search starts from the nodes shared with the previous one.
+    // Large batches are split in contiguous ranges of sorted positions, searched in parallel. One result per position, in the same order
+    void GetNodeAddressesFromPositions( TArray< FSVONodeAddressFromPosition > & results, const TArray< FVector > & positions ) const;
     void GetNodeNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & node_address ) const;
+    // True when the address points to an existing node of this volume
+    bool ContainsNodeAddress( const FSVONodeAddress & address ) const;
     float GetLayerRatio( LayerIndex layer_index ) const;
     float GetLayerInverseRatio( LayerIndex layer_index ) const;
     float GetNodeExtentFromNodeAddress( FSVONodeAddress node_address ) const;
-    TOptional< FNavLocation > GetRandomPoint() const;
+    // The node reference of the location identifies this volume with volume_index
+    TOptional< FNavLocation > GetRandomPoint( int32 volume_index ) const;
+    const FSVODynamicObstacles & GetDynamicObstacles() const;
+    // The obstacles block the nodes they intersect until they are removed, without generating the data again. The copies of this object keep the previous obstacles
+    void AddDynamicObstacle( int32 obstacle_id, const FSVODynamicObstacle & obstacle );
+    bool RemoveDynamicObstacle( int32 obstacle_id );
 
     void GenerateNavigationData( const FBox & volume_bounds, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
+    // Only rasterizes again the layer 1 nodes which intersect the dirty areas, but still builds the layers and the links of the whole volume. Falls back to a full generation if the existing data can't be reused
+    void UpdateNavigationData( const TArray< FBox > & dirty_areas, const FSVOVolumeNavigationDataGenerationSettings & generation_settings );
     void Serialize( FArchive & archive, const ESVOVersion version );
     void Reset();
 
 private:
+    // The leaf nodes of the layer 1 nodes which don't need to be rasterized again
+    struct FReusableLeafNodes
+    {
+        // Sorted
+        TArray< MortonCode > LayerOneMortonCodes;
+        // 8 per layer 1 node
+        TArray< uint_fast64_t > SubNodes;
+    };
+
     int GetLayerCount() const;
+    void ChangeOctreeId();
+    bool IsGenerationCancelled() const;
+    void BeginGenerationPhase( ESVOGenerationPhase phase, int32 node_count ) const;
+    void AddGenerationNodesToProcess( int32 node_count ) const;
+    void AddGenerationProcessedNodes( int32 node_count ) const;
+    void AddGenerationOverlapQuery() const;
     bool IsPositionOccluded( const FVector & position, float box_extent ) const;
     void FirstPassRasterization();
-    void RasterizeLeaf( const FVector & node_position, const LeafIndex leaf_index );
-    void RasterizeInitialLayer( TMap< LeafIndex, MortonCode > & leaf_index_to_layer_one_node_index_map );
+    void GetDirtyLayerOneMortonCodes( TArray< MortonCode > & morton_codes, const TArray< FBox > & dirty_areas ) const;
+    void BuildOctree( const FReusableLeafNodes & reusable_leaf_nodes );
+    void PropagateBlockedNodes();
+    uint_fast64_t RasterizeLeaf( const FVector & node_position ) const;
+    uint_fast64_t RasterizeLeafWithGeometrySnapshot( const FVector & node_position ) const;
+    uint_fast64_t RasterizeLeafWithPhysicsScene( const FVector & node_position ) const;
+    void RasterizeInitialLayer( const FReusableLeafNodes & reusable_leaf_nodes );
     void RasterizeLayer( LayerIndex layer_index );
     int32 GetNodeIndexFromMortonCode( LayerIndex layer_index, MortonCode morton_code ) const;
+    // The morton code of the sub node which contains the position, as if all the leaves had sub nodes. Shifting it by 6 + 3 * layer_index bits gives the morton code of the node of that layer
+    MortonCode GetSubNodeMortonCodeFromPosition( const FVector & position ) const;
+    // Sub node morton codes and indices of the positions, sorted. The positions outside the navigation bounds are not added
+    void GetSortedSubNodeMortonCodesFromPositions( TArray< TPair< MortonCode, int32 > > & sorted_positions, const TArray< FVector > & positions ) const;
+    // Goes down from the node of start_layer_index in layer_node_indices, and stores there the node of each visited layer, down to last_layer_index
+    bool GetNodeAddressFromSubNodeMortonCode( FSVONodeAddress & node_address, LayerIndex & last_layer_index, TStaticArray< NodeIndex, 16 > & layer_node_indices, LayerIndex start_layer_index, MortonCode sub_node_morton_code ) const;
     void BuildNeighborLinks( LayerIndex layer_index );
-    bool FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction );
+    // The neighbor links are not saved in the compressed data
+    void BuildNeighborLinksAfterLoad();
+    // Reads the link stored in the layer, or finds the neighbor when the layer does not store the links
+    FSVONodeAddress GetNodeNeighbor( LayerIndex layer_index, NodeIndex node_index, NeighborDirection direction ) const;
+    // Goes up the parents of the node until a node is found in that direction
+    FSVONodeAddress FindNeighbor( LayerIndex layer_index, NodeIndex node_index, NeighborDirection direction ) const;
+    bool FindNeighborInDirection( FSVONodeAddress & node_address, const LayerIndex layer_index, const NodeIndex node_index, const NeighborDirection direction ) const;
     void GetLeafNeighbors( TArray< FSVONodeAddress > & neighbors, const FSVONodeAddress & leaf_address ) const;
     void GetFreeNodesFromNodeAddress( FSVONodeAddress node_address, TArray< FSVONodeAddress > & free_nodes ) const;
-    void BuildParentLinkForLeafNodes( const TMap< LeafIndex, MortonCode > & leaf_index_to_parent_morton_code_map );
 
     FSVOVolumeNavigationDataGenerationSettings Settings;
     FBox VolumeBounds;
-    FSVOData SVOData;
+    // Shared by the copies of this object, so the data of a volume can be handed over without copying it.
+    // Never modified once generated or loaded: the generation always fills a new instance
+    TSharedRef< FSVOData, ESPMode::ThreadSafe > SVOData;
+    // Not serialized: the references never outlive the session
+    uint64 OctreeId;
+    uint32 Serial;
     TSubclassOf< USVONavigationQueryFilter > VolumeNavigationQueryFilter;
+    // Not serialized. The owner registers its obstacles again when the data is generated.
+    // Shared by the copies of this object like SVOData, and replaced by a modified copy when an obstacle is added or removed
+    TSharedRef< const FSVODynamicObstacles, ESPMode::ThreadSafe > DynamicObstacles;
     bool bInNavigationDataChunk;
 };
 
@@ -97,19 +180,39 @@ FORCEINLINE const FBox & FSVOVolumeNavigationData::GetVolumeBounds() const
 
 FORCEINLINE const FBox & FSVOVolumeNavigationData::GetNavigationBounds() const
 {
-    return SVOData.GetNavigationBounds();
+    return SVOData->GetNavigationBounds();
 }
 
 FORCEINLINE const FSVOData & FSVOVolumeNavigationData::GetData() const
 {
-    return SVOData;
+    return *SVOData;
+}
+
+FORCEINLINE uint64 FSVOVolumeNavigationData::GetOctreeId() const
+{
+    return OctreeId;
+}
+
+FORCEINLINE uint32 FSVOVolumeNavigationData::GetSerial() const
+{
+    return Serial;
 }
 
-FORCEINLINE const FSVONode & FSVOVolumeNavigationData::GetNodeFromAddress( const FSVONodeAddress & address ) const
+FORCEINLINE void FSVOVolumeNavigationData::SetSerial( const uint32 serial )
+{
+    Serial = serial;
+}
+
+FORCEINLINE NavNodeRef FSVOVolumeNavigationData::GetNavNodeRef( const FSVONodeAddress & address, const int32 volume_index ) const
+{
+    return address.GetNavNodeRef( volume_index, Serial );
+}
+
+FORCEINLINE FSVONode FSVOVolumeNavigationData::GetNodeFromAddress( const FSVONodeAddress & address ) const
 {
     return address.LayerIndex < 15
-               ? SVOData.GetLayer( address.LayerIndex ).GetNode( address.NodeIndex )
-               : SVOData.GetLastLayer().GetNode( 0 );
+               ? SVOData->GetLayer( address.LayerIndex ).GetNode( address.NodeIndex )
+               : SVOData->GetLastLayer().GetNode( 0 );
 }
 
 FORCEINLINE TSubclassOf< USVONavigationQueryFilter > FSVOVolumeNavigationData::GetVolumeNavigationQueryFilter() const
@@ -122,7 +225,53 @@ FORCEINLINE void FSVOVolumeNavigationData::SetVolumeNavigationQueryFilter( TSubc
     VolumeNavigationQueryFilter = navigation_query_filter;
 }
 
+FORCEINLINE const FSVODynamicObstacles & FSVOVolumeNavigationData::GetDynamicObstacles() const
+{
+    return *DynamicObstacles;
+}
+
 FORCEINLINE int FSVOVolumeNavigationData::GetLayerCount() const
 {
-    return SVOData.GetLayerCount();
+    return SVOData->GetLayerCount();
+}
+
+FORCEINLINE bool FSVOVolumeNavigationData::IsGenerationCancelled() const
+{
+    return Settings.GenerationState.IsValid() && Settings.GenerationState->IsCancelled();
+}
+
+FORCEINLINE void FSVOVolumeNavigationData::BeginGenerationPhase( const ESVOGenerationPhase phase, const int32 node_count ) const
+{
+    if ( Settings.GenerationState.IsValid() )
+    {
+        // The octree only grows between the phases, except for the morton code indices which are released at the end when not kept
+        Settings.GenerationState->UpdatePeakAllocatedSize( SVOData->GetAllocatedSize() );
+        Settings.GenerationState->BeginPhase( phase, node_count );
+    }
+}
+
+FORCEINLINE void FSVOVolumeNavigationData::AddGenerationNodesToProcess( const int32 node_count ) const
+{
+    if ( Settings.GenerationState.IsValid() )
+    {
+        Settings.GenerationState->AddNodesToProcess( node_count );
+    }
+}
+
+FORCEINLINE void FSVOVolumeNavigationData::AddGenerationProcessedNodes( const int32 node_count ) const
+{
+    if ( Settings.GenerationState.IsValid() )
+    {
+        Settings.GenerationState->AddProcessedNodes( node_count );
+    }
+}
+
+FORCEINLINE void FSVOVolumeNavigationData::AddGenerationOverlapQuery() const
+{
+    INC_DWORD_STAT( STAT_SVONavigation_OverlapQueries );
+
+    if ( Settings.GenerationState.IsValid() )
+    {
+        Settings.GenerationState->AddOverlapQueries( 1 );
+    }
 }
\ No newline at end of file
@@ -47,6 +47,7 @@ public class SVONavigation : ModuleRules
                 "GameplayTasks",
                 "AIModule",
                 "NavigationSystem",
+                "PhysicsCore",
             }
             );
 
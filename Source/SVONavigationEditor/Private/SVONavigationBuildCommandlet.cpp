@@ -0,0 +1,206 @@
+#include "SVONavigationBuildCommandlet.h"
+
+#include "SVONavigationData.h"
+#include "SVONavigationEditor/SVONavigationEditor.h"
+
+#include <Editor.h>
+#include <Engine/LevelStreaming.h>
+#include <EngineUtils.h>
+#include <HAL/PlatformMemory.h>
+#include <Misc/PackageName.h>
+#include <Misc/ScopeExit.h>
+#include <NavigationSystem.h>
+#include <UObject/SavePackage.h>
+
+USVONavigationBuildCommandlet::USVONavigationBuildCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USVONavigationBuildCommandlet::Main( const FString & params )
+{
+    TArray< FString > tokens;
+    TArray< FString > switches;
+    TMap< FString, FString > param_values;
+    ParseCommandLine( *params, tokens, switches, param_values );
+
+    TArray< FString > map_package_names;
+
+    if ( const auto * maps = param_values.Find( TEXT( "Maps" ) ) )
+    {
+        maps->ParseIntoArray( map_package_names, TEXT( "+" ) );
+    }
+
+    if ( map_package_names.Num() == 0 )
+    {
+        UE_LOG( LogSVONavigationEditor, Error, TEXT( "No map to build. Usage: -run=SVONavigationBuild -Maps=/Game/Maps/MapA+/Game/Maps/MapB [-NoSave]" ) );
+        return 1;
+    }
+
+    const auto save = !switches.Contains( TEXT( "NoSave" ) );
+
+    TArray< FMapBuildSummary > summaries;
+    auto has_failed = false;
+
+    for ( const auto & map_package_name : map_package_names )
+    {
+        auto & summary = summaries.AddDefaulted_GetRef();
+        summary.MapName = map_package_name;
+
+        const auto start_time = FPlatformTime::Seconds();
+        summary.bSucceeded = BuildMap( summary, map_package_name, save );
+        summary.BuildTime = FPlatformTime::Seconds() - start_time;
+        summary.PeakUsedPhysicalMemory = FPlatformMemory::GetStats().PeakUsedPhysical;
+
+        has_failed |= !summary.bSucceeded;
+
+        // Release the map before loading the next one
+        CollectGarbage( RF_NoFlags );
+    }
+
+    LogSummaries( summaries );
+
+    return has_failed ? 1 : 0;
+}
+
+bool USVONavigationBuildCommandlet::BuildMap( FMapBuildSummary & summary, const FString & map_package_name, const bool save )
+{
+    FString map_file_name;
+    if ( !FPackageName::TryConvertLongPackageNameToFilename( map_package_name, map_file_name, FPackageName::GetMapPackageExtension() ) || !FPackageName::DoesPackageExist( map_package_name ) )
+    {
+        UE_LOG( LogSVONavigationEditor, Error, TEXT( "The map %s does not exist" ), *map_package_name );
+        return false;
+    }
+
+    auto * package = LoadPackage( nullptr, *map_package_name, LOAD_None );
+    auto * world = package != nullptr ? UWorld::FindWorldInPackage( package ) : nullptr;
+
+    if ( world == nullptr )
+    {
+        UE_LOG( LogSVONavigationEditor, Error, TEXT( "Failed to load the map %s" ), *map_package_name );
+        return false;
+    }
+
+    UE_LOG( LogSVONavigationEditor, Display, TEXT( "Building the SVO navigation data of %s" ), *map_package_name );
+
+    // The volumes are rasterized with overlap queries, so the world needs its physics scene, but nothing needs to be rendered
+    world->WorldType = EWorldType::Editor;
+    world->AddToRoot();
+
+    if ( !world->bIsWorldInitialized )
+    {
+        world->InitWorld( UWorld::InitializationValues()
+                              .AllowAudioPlayback( false )
+                              .RequiresHitProxies( false )
+                              .CreatePhysicsScene( true )
+                              .CreateNavigation( true )
+                              .CreateAISystem( false )
+                              .ShouldSimulatePhysics( false )
+                              .EnableTraceCollision( true ) );
+    }
+
+    auto & world_context = GEditor->GetEditorWorldContext();
+    world_context.SetCurrentWorld( world );
+    GWorld = world;
+
+    // The volumes of the sub levels are built too, and their data is saved in a navigation data chunk of each sub level
+    for ( auto * streaming_level : world->GetStreamingLevels() )
+    {
+        if ( streaming_level != nullptr )
+        {
+            streaming_level->SetShouldBeLoaded( true );
+            streaming_level->SetShouldBeVisible( true );
+        }
+    }
+
+    world->FlushLevelStreaming( EFlushLevelStreamingType::Full );
+    world->UpdateWorldComponents( true, false );
+
+    ON_SCOPE_EXIT
+    {
+        world_context.SetCurrentWorld( nullptr );
+        GWorld = nullptr;
+        world->DestroyWorld( false );
+        world->RemoveFromRoot();
+    };
+
+    auto * navigation_system = FNavigationSystem::GetCurrent< UNavigationSystemV1 >( world );
+
+    if ( navigation_system == nullptr )
+    {
+        UE_LOG( LogSVONavigationEditor, Error, TEXT( "The map %s has no navigation system" ), *map_package_name );
+        return false;
+    }
+
+    // Blocks until all the navigation data is generated
+    navigation_system->Build();
+
+    for ( TActorIterator< ASVONavigationData > iterator( world ); iterator; ++iterator )
+    {
+        for ( const auto & report : iterator->GetGenerationReports() )
+        {
+            summary.VolumeCount++;
+            summary.LeafCount += report.LeafCount;
+            summary.AllocatedSize += report.AllocatedSize;
+        }
+    }
+
+    if ( !save )
+    {
+        return true;
+    }
+
+    // The persistent level holds the navigation data actors, and the sub levels the navigation data chunks
+    TArray< UPackage * > packages_to_save;
+
+    for ( const auto * level : world->GetLevels() )
+    {
+        auto * level_package = level->GetOutermost();
+
+        if ( level_package->IsDirty() || level->IsPersistentLevel() )
+        {
+            packages_to_save.AddUnique( level_package );
+        }
+    }
+
+    auto all_saved = true;
+
+    for ( auto * package_to_save : packages_to_save )
+    {
+        const auto file_name = FPackageName::LongPackageNameToFilename( package_to_save->GetName(), FPackageName::GetMapPackageExtension() );
+
+        FSavePackageArgs save_package_args;
+        save_package_args.TopLevelFlags = RF_Standalone;
+        save_package_args.SaveFlags = SAVE_KeepGUID;
+
+        if ( !UPackage::SavePackage( package_to_save, UWorld::FindWorldInPackage( package_to_save ), *file_name, save_package_args ) )
+        {
+            UE_LOG( LogSVONavigationEditor, Error, TEXT( "Failed to save %s" ), *file_name );
+            all_saved = false;
+        }
+    }
+
+    return all_saved;
+}
+
+void USVONavigationBuildCommandlet::LogSummaries( const TArray< FMapBuildSummary > & summaries ) const
+{
+    UE_LOG( LogSVONavigationEditor, Display, TEXT( "SVO navigation build summary:" ) );
+
+    for ( const auto & summary : summaries )
+    {
+        UE_LOG( LogSVONavigationEditor,
+            Display,
+            TEXT( "  %s : %s in %.2fs - %d volumes, %d leaves, %.2fMB of navigation data - Process peak memory %.2fMB" ),
+            *summary.MapName,
+            summary.bSucceeded ? TEXT( "built" ) : TEXT( "FAILED" ),
+            summary.BuildTime,
+            summary.VolumeCount,
+            summary.LeafCount,
+            summary.AllocatedSize / ( 1024.0 * 1024.0 ),
+            summary.PeakUsedPhysicalMemory / ( 1024.0 * 1024.0 ) );
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+#include <CoreMinimal.h>
+
+#include "SVONavigationBuildCommandlet.generated.h"
+
+/*
+ * Builds the SVO navigation data of maps without opening them in the editor, and saves them with the navigation data chunks of their sub levels.
+ * The volumes of a map are generated in parallel on the worker threads. The maps are built one after the other: split the list between several agents to build more maps at the same time.
+ *
+ * UnrealEditor-Cmd MyProject.uproject -run=SVONavigationBuild -Maps=/Game/Maps/MapA+/Game/Maps/MapB -nullrhi -unattended [-NoSave]
+ */
+UCLASS()
+class USVONavigationBuildCommandlet final : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USVONavigationBuildCommandlet();
+
+    int32 Main( const FString & params ) override;
+
+private:
+    struct FMapBuildSummary
+    {
+        FString MapName;
+        bool bSucceeded = false;
+        double BuildTime = 0.0;
+        int32 VolumeCount = 0;
+        int32 LeafCount = 0;
+        int64 AllocatedSize = 0;
+        uint64 PeakUsedPhysicalMemory = 0;
+    };
+
+    bool BuildMap( FMapBuildSummary & summary, const FString & map_package_name, bool save );
+    void LogSummaries( const TArray< FMapBuildSummary > & summaries ) const;
+};
@@ -8,6 +8,7 @@ public class SVONavigationEditor : ModuleRules
 			"Core", 
 			"CoreUObject", 
 			"Engine",  
+			"NavigationSystem",
 			"SVONavigation", 
 			"InputCore"
 		});